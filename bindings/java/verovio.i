@@ -18,6 +18,10 @@
 %ignore vrv::Toolkit::ResetLogBuffer( );
 %ignore vrv::Toolkit::SetShowBoundingBoxes( bool );
 %ignore vrv::Toolkit::SetCString( const std::string & );
+%ignore vrv::Toolkit::GetCBuffer( int * );
+%ignore vrv::Toolkit::SetCBuffer( std::string && );
+%ignore vrv::Toolkit::RenderToMIDIBuffer( );
+%ignore vrv::Toolkit::RenderToSVGZBuffer( int, bool );
 
 %module verovio
 %include "std_string.i"
@@ -18,6 +18,8 @@
 %ignore vrv::Toolkit::ResetLogBuffer( );
 %ignore vrv::Toolkit::SetShowBoundingBoxes( bool );
 %ignore vrv::Toolkit::SetCString( const std::string & );
+%ignore vrv::Toolkit::GetCBuffer( int * );
+%ignore vrv::Toolkit::SetCBuffer( std::string && );
 
 // Because we transform the strings to dictionaries, we need this module
 %pythonbegin %{
@@ -42,6 +44,12 @@ def getAvailableOptions(toolkit):
     return json.loads($action(toolkit))
 %}
 
+// Toolkit::GetCacheStatistics
+%feature("shadow") vrv::Toolkit::GetCacheStatistics() %{
+def getCacheStatistics(toolkit):
+    return json.loads($action(toolkit))
+%}
+
 // Toolkit::GetDefaultOptions
 %feature("shadow") vrv::Toolkit::GetDefaultOptions() const %{
 def getDefaultOptions(toolkit):
@@ -72,6 +80,15 @@ def getExpansionIdsForElement(toolkit, xml_id):
     return json.loads($action(toolkit, xml_id))
 %}
 
+// Toolkit::GetLog
+%feature("shadow") vrv::Toolkit::GetLog(const std::string & = "") %{
+def getLog(toolkit, options = None):
+    if options == None:
+        return $action(toolkit)
+    log = $action(toolkit, json.dumps(options))
+    return json.loads(log) if options.get("diagnostics", False) else log
+%}
+
 // Toolkit::GetMEI
 %feature("shadow") vrv::Toolkit::GetMEI(const std::string & = "") %{
 def getMEI(toolkit, options = None):
@@ -80,6 +97,14 @@ def getMEI(toolkit, options = None):
     return $action(toolkit, json.dumps(options))
 %}
 
+// Toolkit::GetMEIBuffer
+%feature("shadow") vrv::Toolkit::GetMEIBuffer(const std::string & = "") %{
+def getMEIBuffer(toolkit, options = None):
+    if options == None:
+        options = {}
+    return $action(toolkit, json.dumps(options))
+%}
+
 // Toolkit::GetMIDIValuesForElement
 %feature("shadow") vrv::Toolkit::GetMIDIValuesForElement(const std::string &) %{
 def getMIDIValuesForElement(toolkit, xml_id):
@@ -98,6 +123,12 @@ def getTimesForElement(toolkit, xml_id):
     return json.loads($action(toolkit, xml_id))
 %}
 
+// Toolkit::QueryFeatureIndex
+%feature("shadow") vrv::Toolkit::QueryFeatureIndex(const std::string &) %{
+def queryFeatureIndex(toolkit, query):
+    return json.loads($action(toolkit, json.dumps(query)))
+%}
+
 // Toolkit::RedoLayout
 %feature("shadow") vrv::Toolkit::RedoLayout(const std::string & = "") %{
 def redoLayout(toolkit, options = None):
@@ -134,6 +165,12 @@ def renderToTimemapFile(toolkit, filename, options = None):
     return $action(toolkit, filename, json.dumps(options))
 %}
 
+// Toolkit::RenderTranspositions
+%feature("shadow") vrv::Toolkit::RenderTranspositions(const std::string &, const std::string &) %{
+def renderTranspositions(toolkit, data, options):
+    return json.loads($action(toolkit, data, json.dumps(options)))
+%}
+
 // Toolkit::SaveFile
 %feature("shadow") vrv::Toolkit::SaveFile(const std::string &, const std::string & = "") %{
 def saveFile(toolkit, filename, options = None):
@@ -164,6 +201,12 @@ def validatePAE(toolkit, data):
 
 %module(package="verovio") verovio
 %include "std_string.i"
+
+// Binary outputs are returned as bytes
+%typemap(out) std::string RenderToMIDIBuffer, std::string RenderToSVGBuffer, std::string RenderToSVGZBuffer, std::string GetMEIBuffer %{
+    $result = PyBytes_FromStringAndSize($1.data(), $1.size());
+%}
+
 %include "../../include/vrv/toolkit.h"
 %include "../../include/vrv/toolkitdef.h"
 
@@ -174,3 +217,12 @@ def validatePAE(toolkit, data):
     using namespace vrv;
     using namespace std;
 %}
+
+// Python-only methods returning the output as bytes
+%extend vrv::Toolkit {
+    std::string RenderToSVGBuffer(int pageNo = 1, bool xmlDeclaration = false)
+    {
+        return $self->RenderToSVG(pageNo, xmlDeclaration);
+    }
+    std::string GetMEIBuffer(const std::string &jsonOptions = "") { return $self->GetMEI(jsonOptions); }
+}
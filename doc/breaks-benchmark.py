@@ -0,0 +1,78 @@
+# This script it expected to be run from ./doc with the command-line tool built
+# It generates long MEI scores with measures of varying density and times the rendering of all the pages
+# with --breaks auto and --breaks optimal, with and without --breaks-no-widow.
+# The number of pages and systems, and the number of measures in the last system, are given for each run.
+import argparse
+import os
+import random
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+STEPS = 'cdefgab'
+# Content of 4/4 measures as lists of durations, from sparse to dense
+RHYTHMS = [[1], [2, 2], [4, 4, 4, 4], [8] * 8, [16] * 8 + [4, 4], [16] * 16]
+
+
+def write_score(filename, rng, measures):
+    with open(filename, 'w') as f:
+        f.write('<?xml version="1.0" encoding="UTF-8"?>\n')
+        f.write('<mei xmlns="http://www.music-encoding.org/ns/mei" meiversion="4.0.1">\n')
+        f.write('<meiHead><fileDesc><titleStmt><title>Breaks</title></titleStmt><pubStmt/></fileDesc></meiHead>\n')
+        f.write('<music><body><mdiv><score>\n<scoreDef meter.count="4" meter.unit="4"><staffGrp>'
+                '<staffDef n="1" lines="5" clef.shape="G" clef.line="2"/></staffGrp></scoreDef>\n<section>\n')
+        for n in range(1, measures + 1):
+            notes = ''.join('<note pname="%s" oct="%d" dur="%d"/>' % (rng.choice(STEPS), rng.choice([4, 5]), dur)
+                            for dur in rng.choice(RHYTHMS))
+            f.write('<measure n="%d"><staff n="1"><layer n="1">%s</layer></staff></measure>\n' % (n, notes))
+        f.write('</section>\n</score></mdiv></body></music>\n</mei>\n')
+
+
+def run(command, repeat):
+    elapsed = []
+    for _ in range(repeat):
+        start = time.perf_counter()
+        result = subprocess.run(command, capture_output=True, text=True)
+        elapsed.append(time.perf_counter() - start)
+        if result.returncode != 0:
+            sys.exit('Failed: %s\n%s' % (' '.join(command), result.stderr))
+    return min(elapsed)
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--verovio', default='../tools/verovio')
+    parser.add_argument('--resources', default='../data/')
+    parser.add_argument('--measures', type=int, nargs='+', default=[100, 400, 1600])
+    parser.add_argument('--repeat', type=int, default=3)
+    parser.add_argument('--seed', type=int, default=1)
+    args = parser.parse_args()
+
+    rng = random.Random(args.seed)
+    with tempfile.TemporaryDirectory() as workdir:
+        for measures in args.measures:
+            filename = os.path.join(workdir, 'score-%d.mei' % measures)
+            write_score(filename, rng, measures)
+            base = [args.verovio, '-r', args.resources, '--all-pages', '-o', os.path.join(workdir, 'out.svg')]
+            auto = None
+            for breaks in ['auto', 'optimal']:
+                for options in [[], ['--breaks-no-widow']]:
+                    for svg in os.listdir(workdir):
+                        if svg.endswith('.svg'):
+                            os.remove(os.path.join(workdir, svg))
+                    elapsed = run(base + ['--breaks', breaks] + options + [filename], args.repeat)
+                    if auto is None:
+                        auto = elapsed
+                    pages = sorted(os.path.join(workdir, svg) for svg in os.listdir(workdir) if svg.endswith('.svg'))
+                    systems = 0
+                    for page in pages:
+                        with open(page) as f:
+                            content = f.read()
+                        systems += len(re.findall(r'class="system"', content))
+                    # The SVG of the last page is the last one read
+                    last = len(re.findall(r'class="measure"', content.split('class="system"')[-1]))
+                    print('%5d measures, %-7s %-18s %3d pages, %4d systems, %2d measure(s) in the last one, '
+                          '%8.1fms (%.2fx auto)' % (measures, breaks, ' '.join(options), len(pages), systems, last,
+                                                    elapsed * 1000, elapsed / auto))
@@ -0,0 +1,113 @@
+# This script it expected to be run from ./doc with the command-line tool built
+# It starts the command-line tool as a server on a UNIX socket (--server=<socket>) and checks that the pages
+# rendered after a call that changes the structure of the document are not replayed from the display lists
+# recorded before it. Each file in ./tests/mensural is rendered, exported with getMEI (which converts the mensural
+# cast off back and forth) and rendered again. The pages have to be the same as the ones of the file loaded again
+# and rendered only after getMEI, which are drawn without any display list recorded before.
+import argparse
+import json
+import os
+import re
+import socket
+import subprocess
+import sys
+import tempfile
+import time
+
+
+class Client:
+    def __init__(self, path):
+        self.socket = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        self.socket.connect(path)
+        self.reader = self.socket.makefile('r', encoding='utf-8')
+        self.next_id = 1
+
+    def call(self, method, params={}):
+        request = {'id': self.next_id, 'method': method, 'params': params}
+        self.next_id += 1
+        try:
+            self.socket.sendall((json.dumps(request) + '\n').encode('utf-8'))
+            line = self.reader.readline()
+        except ConnectionError:
+            line = ''
+        if not line:
+            sys.exit('The server has closed the connection during the request %s' % method)
+        response = json.loads(line)
+        if 'error' in response:
+            sys.exit('The request %s failed: %s' % (method, response['error']))
+        return response['result']
+
+    def close(self):
+        self.reader.close()
+        self.socket.close()
+
+
+def connect(server, path, timeout):
+    deadline = time.monotonic() + timeout
+    while True:
+        try:
+            return Client(path)
+        except OSError:
+            if server.poll() is not None:
+                sys.exit('The server has terminated with the exit code %d' % server.returncode)
+            if time.monotonic() > deadline:
+                raise
+            time.sleep(0.05)
+
+
+def render(client, handle):
+    pages = client.call('getPageCount', {'handle': handle})
+    svgs = [client.call('renderToSVG', {'handle': handle, 'pageNo': page}) for page in range(1, pages + 1)]
+    # The IDs of the elements created by the mensural conversion, also in the classes of the milestone ends, and the
+    # postfix of the glyph IDs change each time
+    patterns = [(r' id="[^"]*"', ''), (r'(MilestoneEnd) [^"]*"', r'\1"'), (r'(#E[0-9A-F]+)-[^"]*"', r'\1"')]
+    for pattern, replacement in patterns:
+        svgs = [re.sub(pattern, replacement, svg) for svg in svgs]
+    return svgs
+
+
+def load(client, filename):
+    with open(filename) as f:
+        return client.call('loadData', {'data': f.read()})['handle']
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--verovio', default='../tools/verovio')
+    parser.add_argument('--resources', default='../data/')
+    parser.add_argument('--tests', default='./tests/mensural')
+    args = parser.parse_args()
+
+    failures = 0
+    with tempfile.TemporaryDirectory() as workdir:
+        path = os.path.join(workdir, 'verovio.sock')
+        server = subprocess.Popen([args.verovio, '-r', args.resources, '--server=' + path],
+                                  stderr=subprocess.DEVNULL)
+        try:
+            client = connect(server, path, 10)
+            for name in sorted(os.listdir(args.tests)):
+                filename = os.path.join(args.tests, name)
+                handle = load(client, filename)
+                render(client, handle)
+                client.call('getMEI', {'handle': handle})
+                rendered = render(client, handle)
+                client.call('close', {'handle': handle})
+                handle = load(client, filename)
+                client.call('getMEI', {'handle': handle})
+                expected = render(client, handle)
+                client.call('close', {'handle': handle})
+                if rendered != expected:
+                    failures += 1
+                    print('%s: the pages rendered after getMEI differ' % name)
+                else:
+                    print('%s: ok' % name)
+            client.call('shutdown')
+            client.close()
+            server.wait(timeout=10)
+        finally:
+            if server.poll() is None:
+                server.kill()
+
+    if server.returncode != 0:
+        sys.exit('The server has terminated with the exit code %d' % server.returncode)
+    sys.exit(1 if failures else 0)
@@ -0,0 +1,99 @@
+# This script it expected to be run from ./doc with the command-line tool built
+# It generates a corpus of random Plaine & Easie incipits, builds a feature index with -t feature-index,
+# and times queries of chromatic interval patterns taken from the corpus (repeated -q options).
+# The number of matches is checked against a brute-force scan of the generated melodies.
+import argparse
+import json
+import os
+import random
+import subprocess
+import sys
+import tempfile
+import time
+
+# C major scale over two octaves as (PAE octave mark, PAE pitch, MIDI pitch)
+SCALE = [(octave, step, midi + 12 * i) for i, octave in enumerate(["'", "''"])
+         for step, midi in zip('CDEFGAB', [60, 62, 64, 65, 67, 69, 71])]
+
+
+def generate_melody(rng, notes):
+    index = rng.randrange(len(SCALE))
+    melody = []
+    for _ in range(notes):
+        melody.append(SCALE[index])
+        index = min(max(index + rng.choice([-3, -2, -1, -1, 1, 1, 2, 3, 0]), 0), len(SCALE) - 1)
+    return melody
+
+
+def write_incipit(filename, melody):
+    data = '8' + ''.join(octave + step for octave, step, _ in melody)
+    with open(filename, 'w') as f:
+        f.write('@start:incipit\n@clef:G-2\n@keysig:\n@key:\n@timesig:\n@data:%s\n@end:incipit\n' % data)
+
+
+def count_matches(intervals, pattern):
+    length = len(pattern)
+    return sum(1 for sequence in intervals for i in range(len(sequence) - length + 1)
+               if sequence[i:i + length] == pattern)
+
+
+def run(command):
+    start = time.perf_counter()
+    result = subprocess.run(command, capture_output=True, text=True)
+    if result.returncode != 0:
+        sys.exit('Failed: %s\n%s' % (' '.join(command[:6]), result.stderr))
+    return time.perf_counter() - start, result.stdout
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--verovio', default='../tools/verovio')
+    parser.add_argument('--resources', default='../data/')
+    parser.add_argument('--documents', type=int, default=2000)
+    parser.add_argument('--notes', type=int, default=40)
+    parser.add_argument('--queries', type=int, default=500)
+    parser.add_argument('--seed', type=int, default=1)
+    args = parser.parse_args()
+
+    rng = random.Random(args.seed)
+    with tempfile.TemporaryDirectory() as workdir:
+        files = []
+        intervals = []
+        for i in range(args.documents):
+            melody = generate_melody(rng, args.notes)
+            files.append(os.path.join(workdir, 'incipit-%06d.pae' % i))
+            write_incipit(files[-1], melody)
+            intervals.append([b[2] - a[2] for a, b in zip(melody, melody[1:])])
+
+        index = os.path.join(workdir, 'corpus')
+        elapsed, _ = run([args.verovio, '-r', args.resources, '-f', 'pae', '-t', 'feature-index', '-o', index] + files)
+        size = os.path.getsize(index + '.vfi')
+        print('index: %d documents of %d notes, %d bytes, built in %.2fs' % (args.documents, args.notes, size, elapsed))
+
+        # Patterns from 2 to 10 intervals taken from random positions in the corpus
+        patterns = []
+        for _ in range(args.queries):
+            sequence = rng.choice(intervals)
+            length = rng.randint(2, 10)
+            position = rng.randrange(len(sequence) - length + 1)
+            patterns.append(sequence[position:position + length])
+
+        # The time to load the index with one query is subtracted from the time of all the queries
+        queries = []
+        for pattern in patterns:
+            queries += ['-q', json.dumps({'intervals': pattern, 'limit': 10})]
+        single, _ = min(run([args.verovio] + queries[:2] + [index + '.vfi']) for _ in range(3))
+        total, output = min(run([args.verovio] + queries + [index + '.vfi']) for _ in range(3))
+
+        mismatches = 0
+        matches = 0
+        for pattern, result in zip(patterns, json.loads(output)):
+            count = result['count']
+            matches += count
+            if count != count_matches(intervals, pattern):
+                mismatches += 1
+        per_query = (total - single) / max(1, len(patterns) - 1)
+        print('queries: %d, %d matches, %.3fms per query (load and first query %.1fms)'
+              % (len(patterns), matches, per_query * 1000, single * 1000))
+        if mismatches:
+            sys.exit('%d queries with a number of matches different from the scan' % mismatches)
@@ -0,0 +1,102 @@
+# This script it expected to be run from ./doc with the command-line tool built
+# It converts the Humdrum tests to MIDI with -t hummidi and compares the notes with
+# the '!!!midi-notes:' reference record of each file (pitch@on-off in ticks)
+# The tracks are compared with the optional '!!!midi-tracks:' record (track:channel:program, - for no program)
+import argparse
+import base64
+import os
+import subprocess
+import sys
+
+
+def read_vlq(data, pos):
+    value = 0
+    while True:
+        byte = data[pos]
+        pos += 1
+        value = (value << 7) | (byte & 0x7F)
+        if not byte & 0x80:
+            return value, pos
+
+
+def read_midi(data):
+    notes = []
+    tracks = []
+    track = 0
+    pos = 14
+    while pos < len(data):
+        length = int.from_bytes(data[pos + 4:pos + 8], 'big')
+        end = pos + 8 + length
+        pos += 8
+        tick = 0
+        status = 0
+        on = {}
+        channels = set()
+        program = '-'
+        while pos < end:
+            delta, pos = read_vlq(data, pos)
+            tick += delta
+            if data[pos] & 0x80:
+                status = data[pos]
+                pos += 1
+            if status == 0xFF:
+                pos += 1
+                length, pos = read_vlq(data, pos)
+                pos += length
+            elif status in (0xF0, 0xF7):
+                length, pos = read_vlq(data, pos)
+                pos += length
+            elif status & 0xF0 in (0xC0, 0xD0):
+                if status & 0xF0 == 0xC0:
+                    channels.add(status & 0x0F)
+                    program = str(data[pos])
+                pos += 1
+            else:
+                key, velocity = data[pos], data[pos + 1]
+                pos += 2
+                if status & 0xF0 == 0x90 and velocity > 0:
+                    on[key] = tick
+                    channels.add(status & 0x0F)
+                elif status & 0xF0 in (0x80, 0x90) and key in on:
+                    notes.append('%d@%d-%d' % (key, on.pop(key), tick))
+        for channel in sorted(channels):
+            tracks.append('%d:%d:%s' % (track, channel, program))
+        track += 1
+        pos = end
+    return sorted(notes), tracks
+
+
+def expected_record(filename, name):
+    with open(filename) as f:
+        for line in f:
+            if line.startswith('!!!%s:' % name):
+                return line.split(':', 1)[1].split()
+    return None
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--verovio', default='../tools/verovio')
+    parser.add_argument('--resources', default='../data/')
+    parser.add_argument('--dir', default='./tests/humdrum/')
+    args = parser.parse_args()
+
+    failed = 0
+    for subdir in sorted(os.listdir(args.dir)):
+        for name in sorted(os.listdir(os.path.join(args.dir, subdir))):
+            filename = os.path.join(args.dir, subdir, name)
+            command = [args.verovio, '-r', args.resources, '-t', 'hummidi', '-o', '-', filename]
+            result = subprocess.run(command, capture_output=True)
+            notes, tracks = read_midi(base64.b64decode(result.stdout)) if result.returncode == 0 else ([], [])
+            expected = sorted(expected_record(filename, 'midi-notes') or [])
+            expected_tracks = expected_record(filename, 'midi-tracks')
+            if notes != expected:
+                failed += 1
+                print('FAILED %s\n  expected %s\n  got      %s' % (filename, ' '.join(expected), ' '.join(notes)))
+            elif (expected_tracks is not None) and (tracks != expected_tracks):
+                failed += 1
+                print('FAILED %s\n  expected tracks %s\n  got             %s'
+                      % (filename, ' '.join(expected_tracks), ' '.join(tracks)))
+            else:
+                print('ok %s' % filename)
+    sys.exit(1 if failed else 0)
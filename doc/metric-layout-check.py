@@ -0,0 +1,59 @@
+# This script it expected to be run from ./doc with the command-line tool built
+# It renders all the pages of every file found in the given directories with --metric-layout-check, which draws
+# the notes and rests whose bounding boxes are calculated from the glyph metrics in the horizontal layout and
+# compares them. Any difference is reported and makes the script fail, so the calculation cannot drift from the
+# View drawing code without being noticed.
+import argparse
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+EXTENSIONS = ['.mei', '.musicxml', '.xml', '.mxl', '.krn', '.abc', '.pae']
+WARNING = re.compile(r'The bounding box of .* calculated from the glyph metrics differs from the drawn one')
+
+
+def input_files(paths):
+    for path in paths:
+        if os.path.isfile(path):
+            yield path
+            continue
+        for root, dirs, files in os.walk(path):
+            dirs.sort()
+            for name in sorted(files):
+                if not name.startswith('.') and os.path.splitext(name)[1] in EXTENSIONS:
+                    yield os.path.join(root, name)
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--verovio', default='../tools/verovio')
+    parser.add_argument('--resources', default='../data/')
+    parser.add_argument('paths', nargs='+', help='the files or directories to check')
+    args = parser.parse_args()
+
+    checked = 0
+    failures = 0
+    differences = 0
+    with tempfile.TemporaryDirectory() as workdir:
+        for filename in input_files(args.paths):
+            command = [args.verovio, '-r', args.resources, '--metric-layout-check', '--all-pages',
+                       '-o', os.path.join(workdir, 'out.svg'), filename]
+            if filename.endswith('.pae'):
+                command[1:1] = ['-f', 'pae']
+            result = subprocess.run(command, capture_output=True, text=True)
+            checked += 1
+            if result.returncode != 0:
+                failures += 1
+                print('%s: rendering failed with the exit code %d' % (filename, result.returncode))
+                continue
+            warnings = [line for line in result.stderr.splitlines() if WARNING.search(line)]
+            if warnings:
+                differences += len(warnings)
+                print('%s: %d difference(s)' % (filename, len(warnings)))
+                for warning in warnings:
+                    print('    ' + warning)
+
+    print('%d file(s) checked, %d difference(s), %d failure(s)' % (checked, differences, failures))
+    sys.exit(1 if (differences or failures) else 0)
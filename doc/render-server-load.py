@@ -0,0 +1,115 @@
+# This script it expected to be run from ./doc with the command-line tool built
+# It starts the command-line tool as a server on a UNIX socket (--server=<socket>) and sends it requests from a
+# number of clients connecting one after the other, as the server serves them. Each client loads a file, renders
+# its pages and closes it. Every other client can disconnect without reading the responses, which the server has
+# to survive. The latency of the requests is given by method.
+import argparse
+import json
+import os
+import socket
+import subprocess
+import sys
+import tempfile
+import time
+
+
+class Client:
+    def __init__(self, path):
+        self.socket = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        self.socket.connect(path)
+        self.reader = self.socket.makefile('r', encoding='utf-8')
+        self.next_id = 1
+
+    def send(self, method, params):
+        request = {'id': self.next_id, 'method': method, 'params': params}
+        self.next_id += 1
+        self.socket.sendall((json.dumps(request) + '\n').encode('utf-8'))
+
+    def call(self, method, params={}):
+        try:
+            self.send(method, params)
+            line = self.reader.readline()
+        except ConnectionError:
+            line = ''
+        if not line:
+            sys.exit('The server has closed the connection during the request %s' % method)
+        response = json.loads(line)
+        if 'error' in response:
+            sys.exit('The request %s failed: %s' % (method, response['error']))
+        return response['result']
+
+    def close(self):
+        self.reader.close()
+        self.socket.close()
+
+
+def connect(server, path, timeout):
+    deadline = time.monotonic() + timeout
+    while True:
+        try:
+            return Client(path)
+        except OSError:
+            if server.poll() is not None:
+                sys.exit('The server has terminated with the exit code %d' % server.returncode)
+            if time.monotonic() > deadline:
+                raise
+            time.sleep(0.05)
+
+
+def percentile(values, ratio):
+    values = sorted(values)
+    return values[min(len(values) - 1, int(ratio * len(values)))]
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--verovio', default='../tools/verovio')
+    parser.add_argument('--resources', default='../data/')
+    parser.add_argument('--clients', type=int, default=50)
+    parser.add_argument('--drop', action='store_true', help='every other client disconnects without reading')
+    parser.add_argument('file', help='the file loaded by each client')
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as workdir:
+        path = os.path.join(workdir, 'verovio.sock')
+        server = subprocess.Popen([args.verovio, '-r', args.resources, '--server=' + path],
+                                  stderr=subprocess.DEVNULL)
+        latencies = {}
+        start = time.perf_counter()
+        try:
+            with open(args.file) as f:
+                data = f.read()
+            for i in range(args.clients):
+                client = connect(server, path, 10)
+                if args.drop and (i % 2 == 1):
+                    # Send the requests and leave without reading any response
+                    client.send('loadData', {'data': data})
+                    client.send('renderToSVG', {'handle': 0, 'pageNo': 1})
+                    client.close()
+                    continue
+                def timed(method, params={}):
+                    request_start = time.perf_counter()
+                    result = client.call(method, params)
+                    latencies.setdefault(method, []).append(time.perf_counter() - request_start)
+                    return result
+                result = timed('loadData', {'data': data})
+                for page in range(1, result['pageCount'] + 1):
+                    timed('renderToSVG', {'handle': result['handle'], 'pageNo': page})
+                timed('close', {'handle': result['handle']})
+                client.close()
+            # The server has to be still running
+            client = connect(server, path, 1)
+            client.call('shutdown')
+            client.close()
+            server.wait(timeout=10)
+        finally:
+            if server.poll() is None:
+                server.kill()
+        elapsed = time.perf_counter() - start
+
+    print('%d clients in %.2fs, server exit code %d' % (args.clients, elapsed, server.returncode))
+    for method, values in latencies.items():
+        print('%-12s %5d requests, median %7.2fms, p95 %7.2fms, max %7.2fms'
+              % (method, len(values), percentile(values, 0.5) * 1000, percentile(values, 0.95) * 1000,
+                 max(values) * 1000))
+    sys.exit(0 if server.returncode == 0 else 1)
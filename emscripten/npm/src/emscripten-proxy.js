@@ -27,6 +27,9 @@ function getToolkitFunction(VerovioModule, method) {
     // char *getAvailableOptions(Toolkit *ic)
     mapping.getAvailableOptions = VerovioModule.cwrap("vrvToolkit_getAvailableOptions", "string", ["number"]);
 
+    // char *getCacheStatistics(Toolkit *ic)
+    mapping.getCacheStatistics = VerovioModule.cwrap("vrvToolkit_getCacheStatistics", "string", ["number"]);
+
     // char *getDefaultOptions(Toolkit *ic)
     mapping.getDefaultOptions = VerovioModule.cwrap("vrvToolkit_getDefaultOptions", "string", ["number"]);
 
@@ -57,9 +60,15 @@ function getToolkitFunction(VerovioModule, method) {
     // char *getLog(Toolkit *ic)
     mapping.getLog = VerovioModule.cwrap("vrvToolkit_getLog", "string", ["number"]);
 
+    // char *getLogWithOptions(Toolkit *ic, const char *options)
+    mapping.getLogWithOptions = VerovioModule.cwrap("vrvToolkit_getLogWithOptions", "string", ["number", "string"]);
+
     // char *getMEI(Toolkit *ic, const char *options)
     mapping.getMEI = VerovioModule.cwrap("vrvToolkit_getMEI", "string", ["number", "string"]);
 
+    // unsigned char *getMEIBuffer(Toolkit *ic, const char *options, int *length)
+    mapping.getMEIBuffer = cwrapBuffer(VerovioModule, "vrvToolkit_getMEIBuffer", ["number", "string"]);
+
     // char *vrvToolkit_getNotatedIdForElement(Toolkit *tk, const char *xmlId);
     mapping.getNotatedIdForElement = VerovioModule.cwrap("vrvToolkit_getNotatedIdForElement", "string", ["number", "string"]);
 
@@ -102,18 +111,33 @@ function getToolkitFunction(VerovioModule, method) {
     // char *renderData(Toolkit *ic, const char *data, const char *options)
     mapping.renderData = VerovioModule.cwrap("vrvToolkit_renderData", "string", ["number", "string", "string"]);
 
+    // char *renderToGlyphSprite(Toolkit *ic)
+    mapping.renderToGlyphSprite = VerovioModule.cwrap("vrvToolkit_renderToGlyphSprite", "string", ["number"]);
+
     // char *renderToMIDI(Toolkit *ic, const char *rendering_options)
     mapping.renderToMIDI = VerovioModule.cwrap("vrvToolkit_renderToMIDI", "string", ["number", "string"]);
 
+    // unsigned char *renderToMIDIBuffer(Toolkit *ic, int *length)
+    mapping.renderToMIDIBuffer = cwrapBuffer(VerovioModule, "vrvToolkit_renderToMIDIBuffer", ["number"]);
+
     // char *renderToPAE(Toolkit *ic)
     mapping.renderToPAE = VerovioModule.cwrap("vrvToolkit_renderToPAE", "string");
 
     // char *renderToSvg(Toolkit *ic, int pageNo, int xmlDeclaration)
     mapping.renderToSVG = VerovioModule.cwrap("vrvToolkit_renderToSVG", "string", ["number", "number", "number"]);
 
+    // unsigned char *renderToSVGBuffer(Toolkit *ic, int pageNo, int xmlDeclaration, int *length)
+    mapping.renderToSVGBuffer = cwrapBuffer(VerovioModule, "vrvToolkit_renderToSVGBuffer", ["number", "number", "number"]);
+
+    // unsigned char *renderToSVGZBuffer(Toolkit *ic, int pageNo, int xmlDeclaration, int *length)
+    mapping.renderToSVGZBuffer = cwrapBuffer(VerovioModule, "vrvToolkit_renderToSVGZBuffer", ["number", "number", "number"]);
+
     // char *renderToTimemap(Toolkit *ic)
     mapping.renderToTimemap = VerovioModule.cwrap("vrvToolkit_renderToTimemap", "string", ["number", "string"]);
 
+    // char *renderTranspositions(Toolkit *ic, const char *data, const char *options)
+    mapping.renderTranspositions = VerovioModule.cwrap("vrvToolkit_renderTranspositions", "string", ["number", "string", "string"]);
+
     // void resetOptions(Toolkit *ic)
     mapping.resetOptions = VerovioModule.cwrap("vrvToolkit_resetOptions", null, ["number"]);
 
@@ -131,3 +155,16 @@ function getToolkitFunction(VerovioModule, method) {
 
     return mapping[method];
 }
+
+// Wrap a function returning a buffer and its length as a Uint8Array.
+// The buffer is copied since a view on the module memory would be detached when the memory grows.
+function cwrapBuffer(VerovioModule, name, argTypes) {
+    const func = VerovioModule.cwrap(name, "number", argTypes.concat(["number"]));
+    return (...args) => {
+        const lengthPtr = VerovioModule._malloc(4);
+        const ptr = func(...args, lengthPtr);
+        const length = VerovioModule.HEAP32[lengthPtr >> 2];
+        VerovioModule._free(lengthPtr);
+        return VerovioModule.HEAPU8.slice(ptr, ptr + length);
+    };
+}
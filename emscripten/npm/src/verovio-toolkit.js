@@ -30,6 +30,10 @@ export class VerovioToolkit {
         return JSON.parse(this.proxy.getAvailableOptions(this.ptr));
     }
 
+    getCacheStatistics() {
+        return JSON.parse(this.proxy.getCacheStatistics(this.ptr));
+    }
+
     getDefaultOptions() {
         return JSON.parse(this.proxy.getDefaultOptions(this.ptr));
     }
@@ -66,14 +70,19 @@ export class VerovioToolkit {
         return this.proxy.convertMEIToHumdrum(this.ptr, data);
     }
 
-    getLog() {
-        return this.proxy.getLog(this.ptr);
+    getLog(options = {}) {
+        const log = this.proxy.getLogWithOptions(this.ptr, JSON.stringify(options));
+        return (options.diagnostics) ? JSON.parse(log) : log;
     }
 
     getMEI(options = {}) {
         return this.proxy.getMEI(this.ptr, JSON.stringify(options));
     }
 
+    getMEIBuffer(options = {}) {
+        return this.proxy.getMEIBuffer(this.ptr, JSON.stringify(options));
+    }
+
     getMIDIValuesForElement(xmlId) {
         return JSON.parse(this.proxy.getMIDIValuesForElement(this.ptr, xmlId));
     }
@@ -150,10 +159,18 @@ export class VerovioToolkit {
         return this.proxy.renderData(this.ptr, data, JSON.stringify(options));
     }
 
+    renderToGlyphSprite() {
+        return this.proxy.renderToGlyphSprite(this.ptr);
+    }
+
     renderToMIDI(options) {
         return this.proxy.renderToMIDI(this.ptr, JSON.stringify(options));
     }
 
+    renderToMIDIBuffer() {
+        return this.proxy.renderToMIDIBuffer(this.ptr);
+    }
+
     renderToPAE() {
         return this.proxy.renderToPAE(this.ptr);
     }
@@ -162,10 +179,22 @@ export class VerovioToolkit {
         return this.proxy.renderToSVG(this.ptr, pageNo, xmlDeclaration);
     }
 
+    renderToSVGBuffer(pageNo = 1, xmlDeclaration = false) {
+        return this.proxy.renderToSVGBuffer(this.ptr, pageNo, xmlDeclaration);
+    }
+
+    renderToSVGZBuffer(pageNo = 1, xmlDeclaration = false) {
+        return this.proxy.renderToSVGZBuffer(this.ptr, pageNo, xmlDeclaration);
+    }
+
     renderToTimemap(options = {}) {
         return JSON.parse(this.proxy.renderToTimemap(this.ptr, JSON.stringify(options)));
     }
 
+    renderTranspositions(data, options) {
+        return JSON.parse(this.proxy.renderTranspositions(this.ptr, data, JSON.stringify(options)));
+    }
+
     resetOptions() {
         this.proxy.resetOptions(this.ptr);
     }
@@ -146,6 +146,17 @@ public:
     bool UpdateHorizontalValues() { return (m_update != BBOX_VERTICAL_ONLY); }
     bool UpdateVerticalValues() { return (m_update != BBOX_HORIZONTAL_ONLY); }
 
+    /**
+     * @name Methods for objects whose bounding boxes are calculated without being drawn
+     * (see View::DrawLayerElementMetrics).
+     * UpdateContentBB stretches the content bounding box of the objects on the stack with logical coordinates
+     * and resets the rotation, as drawing the objects and ending their graphic would do.
+     */
+    ///@{
+    bool IsGraphicActive() const { return (!m_isDeactivatedX && !m_isDeactivatedY); }
+    void UpdateContentBB(int x1, int y1, int x2, int y2, bool updateX, bool updateY);
+    ///@}
+
     /**
      * @name Method for adding description element
      */
@@ -265,6 +265,13 @@ public:
      */
     static std::set<double> SolveCubicPolynomial(double a, double b, double c, double d);
 
+    /**
+     * Solve the cubic equation as above with the roots stored in an array instead of a set.
+     * Returns the number of roots, which are neither sorted nor deduplicated.
+     * Used by CalcBezierParamAtPosition in order to avoid allocating a set for each evaluation.
+     */
+    static int SolveCubicPolynomial(double a, double b, double c, double d, double roots[3]);
+
 private:
     /**
      * Get the rectangles covering the inside of a bounding box given two anchors (e.g., NW and NE, or NE and SE)
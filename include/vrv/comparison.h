@@ -116,6 +116,32 @@ protected:
     InterfaceId m_interfaceId;
 };
 
+//----------------------------------------------------------------------------
+// MeasureInSetComparison
+//----------------------------------------------------------------------------
+
+/**
+ * This class evaluates if the object is a measure contained in a given set.
+ * It can be used as a filter for processing only some of the measures.
+ */
+class MeasureInSetComparison : public ClassIdComparison {
+
+public:
+    MeasureInSetComparison(const std::set<const Object *> *measures) : ClassIdComparison(MEASURE)
+    {
+        m_measures = measures;
+    }
+
+    bool operator()(const Object *object) override
+    {
+        if (!MatchesType(object)) return false;
+        return (m_measures->count(object) > 0);
+    }
+
+protected:
+    const std::set<const Object *> *m_measures;
+};
+
 //----------------------------------------------------------------------------
 // PointingToComparison
 //----------------------------------------------------------------------------
@@ -317,6 +317,8 @@ public:
     static int RGB2Int(char red, char green, char blue) { return (red << 16 | green << 8 | blue); }
 
 private:
+    /** Calculate the text extent from the glyphs - called by GetTextExtent when it is not cached */
+    void CalcTextExtent(const std::u32string &string, TextExtend *extend, bool typeSize);
     void AddGlyphToTextExtend(const Glyph *glyph, TextExtend *extend);
 
 public:
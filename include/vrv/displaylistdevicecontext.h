@@ -0,0 +1,310 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        displaylistdevicecontext.h
+// Author:      Laurent Pugin
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_DISPLAYLIST_DC_H__
+#define __VRV_DISPLAYLIST_DC_H__
+
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------
+
+#include "devicecontext.h"
+
+namespace vrv {
+
+class Object;
+
+//----------------------------------------------------------------------------
+// DisplayListDeviceContext
+//----------------------------------------------------------------------------
+
+/**
+ * This class records the drawing commands of a page in a display list.
+ * The commands (graphics, glyphs, paths, text) are stored with the objects they refer to
+ * and with the pen, brush and font in use when they were issued.
+ * The list can then be replayed into any other device context (e.g., a SvgDeviceContext)
+ * without running the View code again. The objects referred to must not be modified or deleted
+ * between the recording and the replay, which means that the list has to be discarded when
+ * the layout of the page changes.
+ */
+class DisplayListDeviceContext : public DeviceContext {
+public:
+    /**
+     * @name Constructors, destructors, and other standard methods
+     */
+    ///@{
+    DisplayListDeviceContext(bool useGlobalStyling);
+    virtual ~DisplayListDeviceContext();
+    ///@}
+
+    /**
+     * @name Setters
+     */
+    ///@{
+    void SetBackground(int colour, int style = AxSOLID) override;
+    void SetBackgroundImage(void *image, double opacity = 1.0) override;
+    void SetBackgroundMode(int mode) override;
+    void SetTextForeground(int colour) override;
+    void SetTextBackground(int colour) override;
+    void SetLogicalOrigin(int x, int y) override;
+    ///@}
+
+    /**
+     * @name Getters
+     */
+    ///@{
+    Point GetLogicalOrigin() override;
+    ///@}
+
+    /**
+     * @name Drawing methods
+     */
+    ///@{
+    void DrawQuadBezierPath(Point bezier[3]) override;
+    void DrawCubicBezierPath(Point bezier[4]) override;
+    void DrawCubicBezierPathFilled(Point bezier1[4], Point bezier2[4]) override;
+    void DrawCircle(int x, int y, int radius) override;
+    void DrawEllipse(int x, int y, int width, int height) override;
+    void DrawEllipticArc(int x, int y, int width, int height, double start, double end) override;
+    void DrawLine(int x1, int y1, int x2, int y2) override;
+    void DrawPolyline(int n, Point points[], int xOffset, int yOffset) override;
+    void DrawPolygon(int n, Point points[], int xOffset, int yOffset) override;
+    void DrawRectangle(int x, int y, int width, int height) override;
+    void DrawRotatedText(const std::string &text, int x, int y, double angle) override;
+    void DrawRoundedRectangle(int x, int y, int width, int height, int radius) override;
+    void DrawText(const std::string &text, const std::u32string &wtext = U"", int x = VRV_UNSET, int y = VRV_UNSET,
+        int width = VRV_UNSET, int height = VRV_UNSET) override;
+    void DrawMusicText(const std::u32string &text, int x, int y, bool setSmuflGlyph = false) override;
+    void DrawSpline(int n, Point points[]) override;
+    void DrawGraphicUri(int x, int y, int width, int height, const std::string &uri) override;
+    void DrawSvgShape(int x, int y, int width, int height, double scale, pugi::xml_node svg) override;
+    void DrawBackgroundImage(int x = 0, int y = 0) override;
+    ///@}
+
+    /**
+     * Special method for forcing bounding boxes to be updated
+     */
+    void DrawPlaceholder(int x, int y) override;
+
+    /**
+     * @name Method for starting and ending a text
+     */
+    ///@{
+    void StartText(int x, int y, data_HORIZONTALALIGNMENT alignment = HORIZONTALALIGNMENT_left) override;
+    void EndText() override;
+
+    /**
+     * @name Move a text to the specified position, for example when starting a new line.
+     */
+    ///@{
+    void MoveTextTo(int x, int y, data_HORIZONTALALIGNMENT alignment) override;
+    void MoveTextVerticallyTo(int y) override;
+    ///@}
+
+    /**
+     * @name Method for starting and ending a graphic
+     */
+    ///@{
+    void StartGraphic(Object *object, std::string gClass, std::string gId, GraphicID graphicID = PRIMARY,
+        bool prepend = false) override;
+    void EndGraphic(Object *object, View *view) override;
+    ///@}
+
+    /**
+     * @name Method for starting and ending a custom graphic
+     */
+    ///@{
+    void StartCustomGraphic(std::string name, std::string gClass = "", std::string gId = "") override;
+    void EndCustomGraphic() override;
+    ///@}
+
+    /**
+     * @name Methods for re-starting and ending a graphic for objects drawn in separate steps
+     */
+    ///@{
+    void ResumeGraphic(Object *object, std::string gId) override;
+    void EndResumedGraphic(Object *object, View *view) override;
+    ///@}
+
+    /**
+     * @name Method for starting and ending a text graphic
+     */
+    ///@{
+    void StartTextGraphic(Object *object, std::string gClass, std::string gId) override;
+    void EndTextGraphic(Object *object, View *view) override;
+    ///@}
+
+    /**
+     * @name Method for rotating a graphic (clockwise).
+     */
+    ///@{
+    void RotateGraphic(Point const &orig, double angle) override;
+    ///@}
+
+    /**
+     * @name Method for starting and ending page
+     */
+    ///@{
+    void StartPage() override;
+    void EndPage() override;
+    ///@}
+
+    /**
+     * @name Method for adding description element
+     */
+    ///@{
+    void AddDescription(const std::string &text) override;
+    ///@}
+
+    /**
+     * Global styling is the one of the device context the list is recorded for.
+     */
+    bool UseGlobalStyling() override { return m_useGlobalStyling; }
+
+    /**
+     * Replay the recorded commands into the device context.
+     * The width, height and scale of the device context have to be set by the caller beforehand.
+     * The content height, which is set by the View when the page is drawn, is set from the recorded one.
+     */
+    void Replay(DeviceContext *dc);
+
+    /**
+     * Return the number of recorded commands.
+     */
+    int GetCommandCount() const { return (int)m_commands.size(); }
+
+private:
+    /**
+     * The type of a recorded command.
+     * The arguments of each command are stored in the same order as in the corresponding method.
+     */
+    enum DisplayListCommandType {
+        DL_SET_BACKGROUND = 0,
+        DL_SET_BACKGROUND_IMAGE,
+        DL_SET_BACKGROUND_MODE,
+        DL_SET_TEXT_FOREGROUND,
+        DL_SET_TEXT_BACKGROUND,
+        DL_SET_LOGICAL_ORIGIN,
+        DL_DRAW_QUAD_BEZIER_PATH,
+        DL_DRAW_CUBIC_BEZIER_PATH,
+        DL_DRAW_CUBIC_BEZIER_PATH_FILLED,
+        DL_DRAW_CIRCLE,
+        DL_DRAW_ELLIPSE,
+        DL_DRAW_ELLIPTIC_ARC,
+        DL_DRAW_LINE,
+        DL_DRAW_POLYLINE,
+        DL_DRAW_POLYGON,
+        DL_DRAW_RECTANGLE,
+        DL_DRAW_ROTATED_TEXT,
+        DL_DRAW_ROUNDED_RECTANGLE,
+        DL_DRAW_TEXT,
+        DL_DRAW_MUSIC_TEXT,
+        DL_DRAW_SPLINE,
+        DL_DRAW_GRAPHIC_URI,
+        DL_DRAW_SVG_SHAPE,
+        DL_DRAW_BACKGROUND_IMAGE,
+        DL_DRAW_PLACEHOLDER,
+        DL_START_TEXT,
+        DL_END_TEXT,
+        DL_MOVE_TEXT_TO,
+        DL_MOVE_TEXT_VERTICALLY_TO,
+        DL_START_GRAPHIC,
+        DL_END_GRAPHIC,
+        DL_START_CUSTOM_GRAPHIC,
+        DL_END_CUSTOM_GRAPHIC,
+        DL_RESUME_GRAPHIC,
+        DL_END_RESUMED_GRAPHIC,
+        DL_START_TEXT_GRAPHIC,
+        DL_END_TEXT_GRAPHIC,
+        DL_ROTATE_GRAPHIC,
+        DL_START_PAGE,
+        DL_END_PAGE,
+        DL_ADD_DESCRIPTION
+    };
+
+    /**
+     * A recorded command.
+     * Integer arguments are stored in m_args and floating point ones in m_values.
+     * Strings, points, SVG nodes and images are stored in the tables of the device context and
+     * referred to by their index in m_args.
+     * The pen, brush and font are indexes in the corresponding tables (-1 if none was set).
+     */
+    struct DisplayListCommand {
+        DisplayListCommandType m_type;
+        int m_args[6];
+        double m_values[2];
+        Object *m_object;
+        View *m_view;
+        int m_pen;
+        int m_brush;
+        int m_font;
+        bool m_deactivatedX;
+        bool m_deactivatedY;
+    };
+
+    /**
+     * Add a command with the current pen, brush, font and deactivation state.
+     * The arguments are then to be filled in the returned command.
+     */
+    DisplayListCommand &AddCommand(DisplayListCommandType type);
+
+    /**
+     * @name Add a string, a text or a list of points to the tables and return its index
+     */
+    ///@{
+    int AddString(const std::string &string);
+    int AddText(const std::u32string &text);
+    int AddPoints(int n, const Point points[]);
+    ///@}
+
+    /**
+     * Apply the pen, brush, font and deactivation state of a command to the device context.
+     * Only the changes from the previous command are applied.
+     */
+    void ApplyState(DeviceContext *dc, const DisplayListCommand &command);
+
+    /**
+     * Pop the pen, brush and font pushed by ApplyState and reactivate the graphic.
+     */
+    void ResetState(DeviceContext *dc);
+
+public:
+    //
+private:
+    /** The recorded commands */
+    std::vector<DisplayListCommand> m_commands;
+
+    /** The tables of arguments referred to by the commands */
+    std::vector<std::string> m_strings;
+    std::vector<std::u32string> m_texts;
+    std::vector<Point> m_points;
+    std::vector<pugi::xml_node> m_svgNodes;
+    std::vector<void *> m_images;
+
+    /** The tables of pens, brushes and fonts, with consecutive identical values stored once */
+    std::vector<Pen> m_pens;
+    std::vector<Brush> m_brushes;
+    std::vector<FontInfo> m_fonts;
+
+    /** The pen, brush, font and deactivation state currently applied during a replay */
+    int m_currentPen;
+    int m_currentBrush;
+    int m_currentFont;
+    bool m_currentDeactivatedX;
+    bool m_currentDeactivatedY;
+
+    /** The origin set when recording */
+    Point m_origin;
+
+    /** The global styling of the device context the list is recorded for */
+    bool m_useGlobalStyling;
+};
+
+} // namespace vrv
+
+#endif // __VRV_DISPLAYLIST_DC_H__
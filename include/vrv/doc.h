@@ -23,6 +23,7 @@ namespace vrv {
 
 class CastOffPagesParams;
 class DocSelection;
+class FeatureExtractor;
 class FontInfo;
 class Glyph;
 class Pages;
@@ -31,6 +32,36 @@ class Score;
 
 enum DocType { Raw = 0, Rendering, Transcription, Facs };
 
+//----------------------------------------------------------------------------
+// GlyphMetrics
+//----------------------------------------------------------------------------
+
+/**
+ * The metrics of a glyph scaled for a staff size and a grace flag.
+ * The values are the ones calculated by the Doc::GetGlyph* methods.
+ */
+struct GlyphMetrics {
+    int m_x;
+    int m_y;
+    int m_width;
+    int m_height;
+    int m_advX;
+    Point m_stemUpSE;
+    Point m_stemDownNW;
+    bool m_isSet;
+    bool m_hasStemUpSE;
+    bool m_hasStemDownNW;
+};
+
+/**
+ * A flat table of glyph metrics over the SMuFL code range for a staff size and a grace flag.
+ */
+struct GlyphMetricTable {
+    int m_staffSize;
+    bool m_graceSize;
+    std::vector<GlyphMetrics> m_metrics;
+};
+
 //----------------------------------------------------------------------------
 // Doc
 //----------------------------------------------------------------------------
@@ -79,7 +110,12 @@ public:
      */
     ///@{
     const Resources &GetResources() const { return m_resources; }
-    Resources &GetResourcesForModification() { return m_resources; }
+    Resources &GetResourcesForModification()
+    {
+        // The glyphs might be changed
+        m_glyphMetricTables.clear();
+        return m_resources;
+    }
     ///@}
 
     /**
@@ -174,6 +210,12 @@ public:
 
     Point ConvertFontPoint(const Glyph *glyph, const Point &fontPoint, int staffSize, bool graceSize) const;
 
+    /**
+     * Get the position of an anchor of a glyph taking into account the staff and grace sizes.
+     * Return false if the glyph has no such anchor.
+     */
+    bool GetGlyphAnchor(char32_t code, SMuFLGlyphAnchor anchor, int staffSize, bool graceSize, Point &point) const;
+
     /**
      * @name Get the height or width for a text glyph taking into account the grace size.
      * The staff size must already be taken into account in the FontInfo
@@ -253,6 +295,11 @@ public:
      */
     bool ExportFeatures(std::string &output, const std::string &options);
 
+    /**
+     * Extract music features with the given extractor.
+     */
+    bool ExtractFeatures(FeatureExtractor *extractor);
+
     /**
      * Set the initial scoreDef of each page.
      * This is necessary for integrating changes that occur within a page.
@@ -296,13 +343,20 @@ public:
      */
     void CastOffLineDoc();
 
+    /**
+     * Casts off the entire document, with system breaks minimizing the underfull and overfull
+     * systems over the whole document instead of filling the systems one after the other.
+     */
+    void CastOffOptimalDoc();
+
     /**
      * Casts off the entire document, with options for obeying breaks.
      * @param useSb - true to use the sb from the document.
      * @param usePb - true to use the pb from the document.
      * @param smart - true to sometimes use encoded sb and pb.
+     * @param optimal - true to use the optimal system breaks.
      */
-    void CastOffDocBase(bool useSb, bool usePb, bool smart = false);
+    void CastOffDocBase(bool useSb, bool usePb, bool smart = false, bool optimal = false);
 
     /**
      * Casts off the running elements (headers and footer)
@@ -368,8 +422,20 @@ public:
      * This might be necessary if we have replaced a page in the document.
      * We need to call this because otherwise looking at the page idx will fail.
      * See Doc::LayOut for an example.
+     * This also increments the structure generation since pages or systems have been replaced.
      */
-    void ResetDataPage() { m_drawingPage = NULL; }
+    void ResetDataPage()
+    {
+        m_drawingPage = NULL;
+        ++m_structureGeneration;
+    }
+
+    /**
+     * Return the generation of the document structure.
+     * It is incremented every time pages, systems or the selection are replaced, after which pointers to
+     * objects of the previous structure (e.g., in display lists) must not be used anymore.
+     */
+    unsigned int GetStructureGeneration() const { return m_structureGeneration; }
 
     /**
      * Getter to the drawPage. Normally, getting the page should
@@ -394,11 +460,14 @@ public:
     int GetAdjustedDrawingPageHeight() const;
 
     /**
-     * Setter for markup flag. See corresponding enum in vrvdef.h
+     * Setter and getter for markup flag. See corresponding enum in vrvdef.h
      * Set when reading the file to indicate what markup conversion needs to be applied.
      * See Doc::ConvertMarkupDoc
      */
+    ///@{
     void SetMarkup(int markup) { m_markup |= markup; }
+    int GetMarkup() const { return m_markup; }
+    ///@}
 
     /**
      * @name Setter for and getter for mensural only flag
@@ -472,11 +541,36 @@ private:
      */
     int CalcMusicFontSize();
 
+    /**
+     * @name Methods for the glyph metric tables.
+     * GetGlyphMetrics returns NULL for a code outside the SMuFL range or for a missing glyph.
+     * The table for the staff size and grace flag is built when it is used for the first time.
+     * ResetGlyphMetrics discards the tables when the music font size or the grace factor has changed.
+     */
+    ///@{
+    const GlyphMetrics *GetGlyphMetrics(char32_t code, int staffSize, bool graceSize) const;
+    const GlyphMetricTable &BuildGlyphMetricTable(int staffSize, bool graceSize) const;
+    void ResetGlyphMetrics();
+    ///@}
+
+    /**
+     * Fill m_selectionMeasures with the measures of the selection and the boundary measures required
+     * for drawing the time spanning elements crossing the selection start or end.
+     * The boundary is the contiguous range of measures from the earliest start to the latest end of
+     * the elements crossing the selection, so that the content in between is aligned as well.
+     */
+    void InitSelectionMeasures(Page *unCastOffPage);
+
 public:
     Page *m_selectionPreceding;
     Page *m_selectionFollowing;
     std::string m_selectionStart;
     std::string m_selectionEnd;
+    /**
+     * The measures for which the aligners are reset with a selection.
+     * The aligners of the content outside are left untouched until the selection is reset.
+     */
+    std::set<const Object *> m_selectionMeasures;
 
     /**
      * A copy of the header tree stored as pugi::xml_document
@@ -555,6 +649,12 @@ private:
      */
     bool m_isCastOff;
 
+    /**
+     * The generation of the document structure.
+     * It is never reset so that it cannot match a value taken before a reset.
+     */
+    unsigned int m_structureGeneration;
+
     /*
      * The following values are set in the Doc::SetDrawingPage.
      * They are all current values to be used when drawing a page in a View and
@@ -586,6 +686,16 @@ private:
     /** Current fingering font */
     FontInfo m_fingeringFont;
 
+    /**
+     * The glyph metric tables for the staff sizes and grace flags in use.
+     * They hold the metrics for the current music font size and grace factor.
+     */
+    mutable std::vector<GlyphMetricTable> m_glyphMetricTables;
+    /** The music font size of the glyph metric tables */
+    int m_glyphMetricsFontSize;
+    /** The grace factor of the glyph metric tables */
+    double m_glyphMetricsGraceFactor;
+
     /**
      * A flag to indicate whether the currentScoreDef has been set or not.
      * If yes, ScoreDefSetCurrent will not parse the document (again) unless
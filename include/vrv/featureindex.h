@@ -0,0 +1,146 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        featureindex.h
+// Author:      Laurent Pugin
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_FEATURE_INDEX_H__
+#define __VRV_FEATURE_INDEX_H__
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------
+
+#include "mappedfile.h"
+
+namespace vrv {
+
+class FeatureExtractor;
+
+/**
+ * The type of sequences indexed
+ */
+enum FeatureIndexType {
+    FEATURE_INDEX_INTERVALS_CHROMATIC = 0,
+    FEATURE_INDEX_INTERVALS_DIATONIC,
+    FEATURE_INDEX_CONTOUR,
+    FEATURE_INDEX_TYPE_COUNT
+};
+
+//----------------------------------------------------------------------------
+// FeatureIndex
+//----------------------------------------------------------------------------
+
+/**
+ * This class is an inverted index of melodic n-grams for incipit search across many documents.
+ * The chromatic intervals, the diatonic intervals and the refined contour produced by the FeatureExtractor
+ * are indexed as n-grams pointing to the documents and the positions where they occur.
+ * The index is serialized to a compact binary file that is memory-mapped for queries.
+ * All the n-grams of a sequence are indexed, including the shorter ones at the end of each document,
+ * which makes it possible to query patterns shorter than the n-gram size with a range lookup.
+ */
+class FeatureIndex {
+public:
+    /**
+     * @name Constructors, destructors, and other standard methods
+     */
+    ///@{
+    FeatureIndex();
+    virtual ~FeatureIndex() = default;
+    FeatureIndex(const FeatureIndex &) = delete;
+    FeatureIndex &operator=(const FeatureIndex &) = delete;
+    ///@}
+
+    /**
+     * Clear the index, including the documents added and any index file loaded.
+     */
+    void Reset();
+
+    /**
+     * Add the features of a document to the index.
+     * Return false if the index was loaded from a file, which is read-only.
+     */
+    bool AddDocument(const std::string &name, const FeatureExtractor &extractor);
+
+    /**
+     * Write the index to a file.
+     */
+    bool Save(const std::string &filename);
+
+    /**
+     * Memory-map an index file for queries.
+     * Return false if the file cannot be opened or is not a valid index file.
+     */
+    bool Load(const std::string &filename);
+
+    /**
+     * Query the index with a stringified JSON object and write the matches to a JSON string.
+     * The query has one of the keys "intervals" (an array of chromatic intervals in semitones),
+     * "intervalsDiatonic" (an array of diatonic intervals) or "contour" (a string with the refined contour
+     * symbols, e.g., "uuD"), and optionally a "limit" for the number of matches returned.
+     */
+    bool Query(const std::string &query, std::string &output);
+
+    /**
+     * @name Getters
+     */
+    ///@{
+    int GetDocumentCount() const;
+    int GetNGramSize() const { return m_ngramSize; }
+    ///@}
+
+private:
+    /**
+     * Serialize the documents added into the buffer if necessary and set the view on it.
+     */
+    void Finalize();
+
+    /**
+     * Validate the content of the view and set the pointers to the sections.
+     */
+    bool SetView(const char *data, size_t size);
+
+    /**
+     * Build the key of an n-gram starting at position in a sequence of encoded values.
+     * Values missing at the end of the sequence are encoded as 0.
+     */
+    uint64_t MakeKey(FeatureIndexType type, const uint8_t *sequence, int length, int position) const;
+
+    /**
+     * Encode an interval or a contour symbol in one byte (never 0).
+     */
+    static uint8_t EncodeInterval(int interval);
+    static uint8_t EncodeContour(char contour);
+
+public:
+    //
+private:
+    /** The size of the n-grams (in intervals) */
+    int m_ngramSize;
+
+    /** The documents added and not serialized yet */
+    struct PendingDocument {
+        std::string m_name;
+        std::vector<std::string> m_ids;
+        std::vector<uint8_t> m_sequences[FEATURE_INDEX_TYPE_COUNT];
+    };
+    std::vector<PendingDocument> m_pendingDocuments;
+    bool m_isModified;
+
+    /** The serialized index built from the documents added */
+    std::string m_buffer;
+    /** The index file memory-mapped */
+    MappedFile m_file;
+
+    /** The view on the serialized index (from the buffer or from the file) */
+    const char *m_data;
+    size_t m_size;
+};
+
+} // namespace vrv
+
+#endif // __VRV_FEATURE_INDEX_H__
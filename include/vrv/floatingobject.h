@@ -357,6 +357,12 @@ public:
     curvature_CURVEDIR GetDir() const { return m_dir; }
     ///@}
 
+    /**
+     * Get the top and bottom Bézier curves of the thick curve (see BoundingBox::CalcThickBezier).
+     * They are cached and recalculated only when the points (including the drawingY) or the thickness change.
+     */
+    void GetThickBezier(Point topBezier[4], Point bottomBezier[4]) const;
+
     /**
      * @name Getter and setter for cached x1 and x2
      */
@@ -426,6 +432,17 @@ private:
     /** The cached min or max value (depending on the curvature) */
     mutable int m_cachedMinMaxY;
 
+    /**
+     * @name The cached top and bottom Bézier curves of the thick curve with the points and the thickness
+     * they were calculated for.
+     */
+    ///@{
+    mutable Point m_cachedThickPoints[4];
+    mutable int m_cachedThickness;
+    mutable Point m_cachedTopBezier[4];
+    mutable Point m_cachedBottomBezier[4];
+    ///@}
+
     /** The cached values for x1 and x2 */
     std::pair<int, int> m_cachedX12;
 
@@ -1241,6 +1241,8 @@ public:
  * member 7: the doc
  * member 8: whether to smartly use encoded system breaks
  * member 9: a pointer to the leftover system (last system with only one measure)
+ * member 10: whether to use the optimal system breaks
+ * member 11: the measures starting a new system with the optimal system breaks
  **/
 
 class CastOffSystemsParams : public FunctorParams {
@@ -1256,6 +1258,7 @@ public:
         m_doc = doc;
         m_smart = smart;
         m_leftoverSystem = NULL;
+        m_optimal = false;
     }
     System *m_contentSystem;
     Page *m_page;
@@ -1267,6 +1270,8 @@ public:
     Doc *m_doc;
     bool m_smart;
     System *m_leftoverSystem;
+    bool m_optimal;
+    std::set<const Measure *> m_breakMeasures;
 };
 
 //----------------------------------------------------------------------------
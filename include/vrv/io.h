@@ -9,6 +9,7 @@
 #define __VRV_IO_H__
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 //----------------------------------------------------------------------------
@@ -70,7 +71,14 @@ public:
     std::string GetOutputFormat() { return m_outformat; }
 
     // read
-    virtual bool Import(std::string const &data) { return true; }
+    virtual bool Import(std::string_view data) { return true; }
+
+    /**
+     * Import data from a buffer that can be modified by the importer.
+     * This is used for parsing memory-mapped files in place without copying them.
+     * By default, the buffer is passed as is to Import.
+     */
+    virtual bool ImportInPlace(char *data, size_t length) { return this->Import(std::string_view(data, length)); }
 
     /**
      * Getter for layoutInformation flag that is set to true during import
@@ -47,7 +47,7 @@ public:
     ABCInput(Doc *doc);
     virtual ~ABCInput();
 
-    bool Import(const std::string &abc) override;
+    bool Import(std::string_view abc) override;
 
 #ifndef NO_ABC_SUPPORT
 
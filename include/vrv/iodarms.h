@@ -40,7 +40,7 @@ public:
     DarmsInput(Doc *doc);
     virtual ~DarmsInput();
 
-    bool Import(const std::string &data) override;
+    bool Import(std::string_view data) override;
 
 private:
     int do_Note(int pos, const char *data, bool rest);
@@ -425,7 +425,7 @@ public:
     HumdrumInput(vrv::Doc *doc);
     virtual ~HumdrumInput();
 
-    bool Import(const std::string &humdrum) override;
+    bool Import(std::string_view humdrum) override;
 
     void parseEmbeddedOptions(vrv::Doc *doc);
     void finalizeDocument(vrv::Doc *doc);
@@ -10,6 +10,8 @@
 
 #include <sstream>
 #include <stack>
+#include <unordered_map>
+#include <unordered_set>
 
 //----------------------------------------------------------------------------
 
@@ -196,6 +198,14 @@ public:
      */
     bool Export();
 
+    /**
+     * Export the file to MEI by writing it to a stream.
+     * The xml elements are written to the stream during the traversal as soon as they are complete
+     * and are then removed from the xml tree, which is never built entirely.
+     * With a filter, the traversal stops as soon as the end of the filter is reached.
+     */
+    bool Export(std::ostream &stream);
+
     /**
      * The main method for writing objects.
      */
@@ -298,6 +308,27 @@ private:
     void WriteStackedObjectsEnd();
     ///@}
 
+    /**
+     * Push and pop a node on the xml node stack, also counted in the set of the nodes in the stack
+     */
+    ///@{
+    void PushNode(pugi::xml_node node);
+    pugi::xml_node PopNode();
+    ///@}
+
+    /**
+     * Streaming of the xml elements to the output stream.
+     * Only the children of the containers listed in IsStreamedNode are written before the end of the export.
+     * The start tag of a container is written with its first child, and its end tag when it is closed.
+     */
+    ///@{
+    bool IsStreamedNode(pugi::xml_node node) const;
+    void StreamNode(pugi::xml_node node);
+    void StreamOpenNode(pugi::xml_node node);
+    void StreamCloseNode();
+    void StreamChildren(pugi::xml_node node, pugi::xml_node end);
+    ///@}
+
     /**
      * Scoredef manipulation
      */
@@ -550,6 +581,15 @@ public:
     //
 private:
     std::ostringstream m_streamStringOutput;
+    /** The stream the xml elements are written to during the export */
+    std::ostream *m_stream;
+    /** The containers with their start tag written to the stream, and their end tag */
+    std::vector<std::pair<pugi::xml_node, std::string>> m_streamedNodes;
+    /** The depth of the containers in m_streamedNodes (their position + 1) */
+    std::unordered_map<pugi::xml_node_struct *, int> m_streamedNodeDepths;
+    /** The indentation string and the pugi flags for the output */
+    std::string m_indentString;
+    unsigned int m_outputFlags;
     int m_indent;
     bool m_scoreBasedMEI;
     /** A flag indicating that we want to produce MEI basic */
@@ -560,6 +600,8 @@ private:
     pugi::xml_node m_currentNode;
     /** Xml node stack */
     std::list<pugi::xml_node> m_nodeStack;
+    /** The nodes in the stack, where the same node can be more than once */
+    std::unordered_multiset<pugi::xml_node_struct *> m_nodeStackSet;
     /** Boundary objects which are merged into one xml element */
     std::stack<Object *> m_boundaries;
     /** The object stack */
@@ -600,7 +642,8 @@ public:
     MEIInput(Doc *doc);
     virtual ~MEIInput();
 
-    bool Import(const std::string &mei) override;
+    bool Import(std::string_view mei) override;
+    bool ImportInPlace(char *mei, size_t length) override;
 
 private:
     bool ReadDoc(pugi::xml_node root);
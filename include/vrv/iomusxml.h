@@ -180,11 +180,12 @@ public:
     virtual ~MusicXmlInput();
 
 #ifndef NO_MUSICXML_SUPPORT
-    bool Import(const std::string &musicxml) override;
+    bool Import(std::string_view musicxml) override;
+    bool ImportInPlace(char *musicxml, size_t length) override;
 
 private:
     /*
-     * Top level method called from ImportFile or Import
+     * Top level method called from Import or ImportInPlace
      */
     bool ReadMusicXml(pugi::xml_node root);
 
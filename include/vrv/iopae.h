@@ -411,7 +411,7 @@ public:
     void SetScoreBased(bool scoreBased) {}
 
 #ifndef NO_PAE_SUPPORT
-    bool Import(const std::string &pae) override;
+    bool Import(std::string_view pae) override;
 
 private:
     // function declarations:
@@ -529,7 +529,7 @@ public:
     void SetScoreBased(bool scoreBased) { m_scoreBased = scoreBased; }
 
 #ifndef NO_PAE_SUPPORT
-    bool Import(const std::string &input) override;
+    bool Import(std::string_view input) override;
 
 private:
     /**
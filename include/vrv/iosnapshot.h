@@ -0,0 +1,196 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        iosnapshot.h
+// Author:      Laurent Pugin
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_IOSNAPSHOT_H__
+#define __VRV_IOSNAPSHOT_H__
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+//----------------------------------------------------------------------------
+
+#include "io.h"
+#include "vrvdef.h"
+
+namespace vrv {
+
+/**
+ * The signature and the version of the snapshot format.
+ * The version has to be incremented every time the content of the snapshot changes.
+ */
+#define SNAPSHOT_SIGNATURE "VRVSNAP"
+#define SNAPSHOT_VERSION 1
+
+//----------------------------------------------------------------------------
+// SnapshotOutput
+//----------------------------------------------------------------------------
+
+/**
+ * This class writes a binary snapshot of a document as imported.
+ * The snapshot stores the tree of objects in pre-order with, for each object, the class, the ID, the attributes
+ * and the state that is not held in attributes (e.g., the text content or the page-based milestone links).
+ * Strings are stored once in a string table and the attribute sets shared by objects are stored once in a table.
+ * All values are stored as 32-bit little-endian integers, which makes the snapshot readable directly from a
+ * memory-mapped file.
+ */
+class SnapshotOutput : public Output {
+public:
+    /**
+     * @name Constructors, destructors, and other standard methods
+     */
+    ///@{
+    SnapshotOutput(Doc *doc, LayoutInformation layoutInformation);
+    virtual ~SnapshotOutput();
+    ///@}
+
+    /**
+     * Return the snapshot of the document as a binary string.
+     */
+    std::string GetOutput();
+
+private:
+    /**
+     * Write the record of the object and of its descendants.
+     */
+    void WriteTree(Object *object);
+
+    /**
+     * Write the state of the object that is not held in attributes.
+     */
+    void WritePayload(Object *object, std::vector<uint32_t> &payload);
+
+    /**
+     * Return the argument the object has to be constructed with (e.g., the start of a milestone end).
+     */
+    uint32_t GetCtorArg(Object *object) const;
+
+    /**
+     * Return the index of a string or of an attribute set, adding it to the table if necessary.
+     */
+    ///@{
+    uint32_t AddString(const std::string &string);
+    uint32_t AddAttributeSet(Object *object);
+    ///@}
+
+public:
+    //
+private:
+    /** The layout information of the input */
+    LayoutInformation m_layoutInformation;
+
+    /** The string table */
+    std::vector<std::string> m_strings;
+    std::unordered_map<std::string, uint32_t> m_stringIndexes;
+
+    /** The attribute set table as a sequence of class name, attribute count and name / value pairs */
+    std::vector<uint32_t> m_attributeSets;
+    std::map<std::vector<uint32_t>, uint32_t> m_attributeSetIndexes;
+
+    /** The object records */
+    std::vector<uint32_t> m_records;
+    std::unordered_map<const Object *, uint32_t> m_objectIndexes;
+
+    /** The factory names of the classes */
+    std::unordered_map<int, std::string> m_classNames;
+};
+
+//----------------------------------------------------------------------------
+// SnapshotInput
+//----------------------------------------------------------------------------
+
+/**
+ * This class restores a document from a binary snapshot written by SnapshotOutput.
+ * The snapshot holds the document as imported and not as prepared. It stores the attributes as strings and not as
+ * typed values. The attributes of each distinct attribute set are parsed only once into a prototype object.
+ * The objects are then cloned from the prototypes, which copies the typed attribute values without parsing them.
+ * The data links (e.g., @startid / @endid) are resolved by Doc::PrepareData, as with any other input.
+ * Only the XML parsing and the attribute parsing of the objects sharing an attribute set are saved.
+ */
+class SnapshotInput : public Input {
+public:
+    /**
+     * @name Constructors, destructors, and other standard methods
+     */
+    ///@{
+    SnapshotInput(Doc *doc);
+    virtual ~SnapshotInput();
+    ///@}
+
+    bool Import(std::string_view data) override;
+
+    /**
+     * Return true if the data starts with the snapshot signature.
+     */
+    static bool IsSnapshot(std::string_view data);
+
+private:
+    /**
+     * Read the record of an object and of its descendants.
+     * The object is created and added to the parent unless a target is given.
+     * Return NULL in case of an error.
+     */
+    Object *ReadTree(Object *parent, Object *target = NULL);
+
+    /**
+     * Create the object for an attribute set and the constructor argument.
+     */
+    Object *CreateObject(uint32_t attributeSet, uint32_t ctorArg);
+
+    /**
+     * Create an object from its class name and set the attributes of the attribute set.
+     * This is done once for each prototype and for the objects that cannot be cloned.
+     */
+    Object *ConstructObject(const std::string &className, uint32_t ctorArg);
+    void SetAttributes(Object *object, uint32_t attributeSet);
+
+    /**
+     * Restore the state of the object that is not held in attributes.
+     */
+    bool ReadPayload(Object *object, const unsigned char *payload, uint32_t count);
+
+    /**
+     * @name Methods for accessing the buffer
+     * The words are read byte by byte since the buffer is not necessarily aligned.
+     */
+    ///@{
+    bool ReadWords(uint32_t count, const unsigned char *&words);
+    uint32_t GetWord(const unsigned char *words, uint32_t index) const;
+    std::string_view GetString(uint32_t index) const;
+    ///@}
+
+public:
+    //
+private:
+    /** The sections of the buffer */
+    const unsigned char *m_data;
+    uint32_t m_stringCount;
+    const unsigned char *m_stringOffsets;
+    const char *m_stringData;
+    std::vector<uint32_t> m_attributeSetOffsets;
+    const unsigned char *m_attributeSets;
+
+    /** The current position and the end of the object records */
+    const unsigned char *m_position;
+    const unsigned char *m_end;
+
+    /** A flag indicating that a facsimile follows the document */
+    bool m_hasFacsimile;
+
+    /** The objects read in pre-order, used to resolve the milestone links */
+    std::vector<Object *> m_objects;
+
+    /** The prototypes for each attribute set and constructor argument */
+    std::map<std::pair<uint32_t, uint32_t>, Object *> m_prototypes;
+};
+
+} // namespace vrv
+
+#endif // __VRV_IOSNAPSHOT_H__
@@ -0,0 +1,81 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        mappedfile.h
+// Author:      Laurent Pugin
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_MAPPEDFILE_H__
+#define __VRV_MAPPEDFILE_H__
+
+#include <string>
+#include <string_view>
+
+//----------------------------------------------------------------------------
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// MappedFile
+//----------------------------------------------------------------------------
+
+/**
+ * This class gives access to the content of a file as a contiguous buffer of bytes.
+ * On POSIX systems, the file is memory-mapped privately, which means that the buffer can be modified
+ * (e.g., parsed in place) without the changes being written back to the file.
+ * On other systems, the content of the file is read into a buffer owned by the object.
+ */
+class MappedFile {
+public:
+    /**
+     * @name Constructors, destructors, and other standard methods
+     */
+    ///@{
+    MappedFile();
+    virtual ~MappedFile();
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    ///@}
+
+    /**
+     * Open the file and map its content.
+     * Return false if the file cannot be opened or mapped.
+     */
+    bool Open(const std::string &filename);
+
+    /**
+     * Unmap the file and release the buffer.
+     */
+    void Close();
+
+    /**
+     * @name Getters for the content of the file
+     */
+    ///@{
+    bool IsOpen() const { return m_isOpen; }
+    char *GetData() { return m_data; }
+    size_t GetSize() const { return m_size; }
+    std::string_view GetView() const { return std::string_view(m_data, m_size); }
+    ///@}
+
+private:
+    //
+public:
+    //
+private:
+    /** The start of the buffer (NULL for empty files) */
+    char *m_data;
+    /** The size of the buffer in bytes */
+    size_t m_size;
+    /** A flag indicating that the file was successfully opened */
+    bool m_isOpen;
+    /** A flag indicating that the buffer is a memory map (and not a buffer we own) */
+    bool m_isMapped;
+    /** The buffer used when memory mapping is not available */
+    std::string m_buffer;
+
+}; // class MappedFile
+
+} // namespace vrv
+
+#endif // __VRV_MAPPEDFILE_H__
@@ -83,6 +83,25 @@ public:
      */
     bool HasCachedHorizontalLayout() const { return (m_cachedWidth != VRV_UNSET); }
 
+    /**
+     * Calculate the signature of the measure content for the horizontal layout.
+     * It includes the alignments, the aligned elements with their bounding boxes, the internal ties and the context
+     * of the measure in the system. Measures with the same signature on a page get the same horizontal layout.
+     * Return false if the layout of the measure cannot be copied (multiple layers, cross-staff or grace notes).
+     * Called from Page::LayOutHorizontally after the bounding boxes have been filled.
+     */
+    bool CalcHorizontalLayoutSignature(std::vector<int> &signature);
+
+    /**
+     * @name Get and set the horizontal layout positions of the measure
+     * These are the xRel of the alignments followed by the drawingXRel of the aligned elements, in the order of the
+     * signature (see Measure::CalcHorizontalLayoutSignature)
+     */
+    ///@{
+    void GetHorizontalLayoutPositions(std::vector<int> &positions) const;
+    void SetHorizontalLayoutPositions(const std::vector<int> &positions);
+    ///@}
+
     /**
      * Get the X drawing position
      */
@@ -212,6 +231,15 @@ public:
      */
     int GetDrawingOverflow();
 
+    /**
+     * @name Return the width and the right overflow used for casting off the systems.
+     * The cached values are returned when the horizontal layout is cached.
+     */
+    ///@{
+    int GetCastOffWidth() const;
+    int GetCastOffOverflow();
+    ///@}
+
     /**
      * Calculates the section restart shift
      */
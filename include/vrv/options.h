@@ -55,7 +55,7 @@ class OptionGrp;
 // Option defines
 //----------------------------------------------------------------------------
 
-enum option_BREAKS { BREAKS_none = 0, BREAKS_auto, BREAKS_line, BREAKS_smart, BREAKS_encoded };
+enum option_BREAKS { BREAKS_none = 0, BREAKS_auto, BREAKS_line, BREAKS_smart, BREAKS_encoded, BREAKS_optimal };
 
 enum option_CONDENSE { CONDENSE_none = 0, CONDENSE_auto, CONDENSE_all, CONDENSE_encoded };
 
@@ -591,9 +591,13 @@ public:
     // These options are only given for documentation - except for m_scale
     // They are ordered by short option alphabetical order
     OptionBool m_standardOutput;
+    OptionString m_server;
+    OptionInt m_serverDocuments;
     OptionBool m_help;
     OptionBool m_allPages;
+    OptionString m_batch;
     OptionString m_inputFrom;
+    OptionInt m_jobs;
     OptionString m_logLevel;
     OptionString m_outfile;
     OptionInt m_page;
@@ -625,7 +629,9 @@ public:
     OptionBool m_justifyVertically;
     OptionBool m_landscape;
     OptionBool m_ligatureAsBracket;
+    OptionBool m_measureLayoutCheck;
     OptionBool m_mensuralToMeasure;
+    OptionBool m_metricLayoutCheck;
     OptionDbl m_minLastJustification;
     OptionBool m_mmOutput;
     OptionBool m_moveScoreDefinitionToStaff;
@@ -642,8 +648,10 @@ public:
     OptionInt m_pageMarginTop;
     OptionInt m_pageWidth;
     OptionIntMap m_pedalStyle;
+    OptionBool m_performanceOnly;
     OptionBool m_preserveAnalyticalMarkup;
     OptionBool m_removeIds;
+    OptionInt m_renderCacheSize;
     OptionBool m_scaleToPageSize;
     OptionBool m_showRuntime;
     OptionBool m_shrinkToFit;
@@ -655,7 +663,11 @@ public:
     OptionBool m_svgHtml5;
     OptionBool m_svgFormatRaw;
     OptionBool m_svgRemoveXlink;
+    OptionString m_svgGlyphSprite;
+    OptionBool m_svgCompact;
+    OptionBool m_svgStripIds;
     OptionArray m_svgAdditionalAttribute;
+    OptionInt m_svgzLevel;
     OptionDbl m_unit;
     OptionBool m_useFacsimile;
     OptionBool m_usePgFooterForAll;
@@ -111,6 +111,12 @@ public:
      */
     void LayOutHorizontallyWithCache(bool restore = false);
 
+    /**
+     * Align the content of the page horizontally for the timing of the alignments only.
+     * Nothing is laid out, which is enough for calculating the timemap and for the MIDI output.
+     */
+    void AlignTiming();
+
     /**
      * Justifiy the content of the page (measures and their content) horizontally
      */
@@ -128,8 +134,9 @@ public:
 
     /**
      * Reset and set the horizontal and vertical alignment
+     * Filters can be given for processing only some of the measures of the page.
      */
-    void ResetAligners();
+    void ResetAligners(Filters *filters = NULL);
 
     /**
      * Lay out the pitch positions and stems (without redoing the entire layout)
@@ -0,0 +1,110 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        rendercache.h
+// Author:      Laurent Pugin
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VRV_RENDERCACHE_H__
+#define __VRV_RENDERCACHE_H__
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+//----------------------------------------------------------------------------
+
+namespace vrv {
+
+/**
+ * The type of output stored in the cache
+ */
+enum RenderCacheType { RENDER_CACHE_SVG = 0, RENDER_CACHE_MIDI, RENDER_CACHE_TIMEMAP, RENDER_CACHE_MEI };
+
+//----------------------------------------------------------------------------
+// RenderCache
+//----------------------------------------------------------------------------
+
+/**
+ * This class is a least-recently-used cache of rendered output.
+ * Entries are keyed by the checksum of the loaded data, the checksum of the serialized options,
+ * the output type, the page number, and the parameters of the rendering call.
+ * The cache is disabled when its maximum size (in bytes) is 0.
+ */
+class RenderCache {
+public:
+    /**
+     * @name Constructors, destructors, and other standard methods
+     */
+    ///@{
+    RenderCache();
+    virtual ~RenderCache() = default;
+    ///@}
+
+    /**
+     * Set the maximum size of the cache in bytes - entries are evicted if necessary.
+     */
+    void SetMaxSize(size_t maxSize);
+    size_t GetMaxSize() const { return m_maxSize; }
+    bool IsEnabled() const { return (m_maxSize > 0); }
+
+    /**
+     * Build a key for an entry.
+     */
+    static std::string MakeKey(unsigned int dataChecksum, unsigned int optionsChecksum, RenderCacheType type,
+        int pageNo, const std::string &params = "");
+
+    /**
+     * Look for an entry and copy it to output if found.
+     * The entry becomes the most recently used one and the hit or miss counter is updated.
+     */
+    bool Get(const std::string &key, std::string &output);
+
+    /**
+     * Add an entry. The least recently used entries are evicted until the cache fits within its maximum size.
+     * Entries larger than the maximum size are not added.
+     */
+    void Add(const std::string &key, const std::string &output);
+
+    /**
+     * Remove all entries. The hit and miss counters are preserved.
+     */
+    void Clear();
+
+    /**
+     * @name Getters for the statistics of the cache
+     */
+    ///@{
+    size_t GetSize() const { return m_size; }
+    int GetEntryCount() const { return (int)m_entries.size(); }
+    int GetHits() const { return m_hits; }
+    int GetMisses() const { return m_misses; }
+    int GetEvictions() const { return m_evictions; }
+    ///@}
+
+private:
+    void Evict();
+
+public:
+    //
+private:
+    typedef std::list<std::pair<std::string, std::string>> ListOfEntries;
+
+    /** The entries, most recently used first */
+    ListOfEntries m_entries;
+    /** The index of the entries by key */
+    std::unordered_map<std::string, ListOfEntries::iterator> m_index;
+    /** The current and the maximum size in bytes */
+    size_t m_size;
+    size_t m_maxSize;
+    /** The counters */
+    int m_hits;
+    int m_misses;
+    int m_evictions;
+
+}; // class RenderCache
+
+} // namespace vrv
+
+#endif // __VRV_RENDERCACHE_H__
@@ -8,6 +8,8 @@
 #ifndef __VRV_RESOURCES_H__
 #define __VRV_RESOURCES_H__
 
+#include <map>
+#include <tuple>
 #include <unordered_map>
 
 //----------------------------------------------------------------------------
@@ -91,6 +93,26 @@ public:
     const Glyph *GetTextGlyph(char32_t code) const;
     ///@}
 
+    /**
+     * Text extent cache
+     * The text extents calculated by DeviceContext::GetTextExtent are cached for the current text style and the point
+     * size. The cache is reset when a font is loaded.
+     * The lookup and the caching are const because they are done through the resources of the device context. They
+     * only change the cache and its statistics. Resetting the cache requires non-const resources.
+     */
+    ///@{
+    /** Returns the cached extent (if any) for the text with the current text style and the point size */
+    const TextExtend *GetCachedTextExtent(const std::u32string &text, int pointSize, bool typeSize) const;
+    /** Add the extent of the text with the current text style and the point size to the cache and return it */
+    const TextExtend *CacheTextExtent(
+        const std::u32string &text, int pointSize, bool typeSize, const TextExtend &extend) const;
+    /** Empty the cache (the hit and miss counts are kept) */
+    void ResetTextExtentCache();
+    int GetTextExtentCacheEntryCount() const { return m_textExtentCacheEntryCount; }
+    int GetTextExtentCacheHits() const { return m_textExtentCacheHits; }
+    int GetTextExtentCacheMisses() const { return m_textExtentCacheMisses; }
+    ///@}
+
     /**
      * Static method that converts unicode music code points to SMuFL equivalent.
      * Return the parameter char if nothing can be converted.
@@ -110,6 +132,17 @@ private:
     /** A text font used for bounding box calculations */
     GlyphTextMap m_textFont;
     mutable StyleAttributes m_currentStyle;
+
+    /**
+     * The cached text extents, with a table per text style, point size and type size flag
+     */
+    ///@{
+    using TextExtentKey = std::tuple<data_FONTWEIGHT, data_FONTSTYLE, int, bool>;
+    mutable std::map<TextExtentKey, std::unordered_map<std::u32string, TextExtend>> m_textExtentCache;
+    mutable int m_textExtentCacheEntryCount;
+    mutable int m_textExtentCacheHits;
+    mutable int m_textExtentCacheMisses;
+    ///@}
     /**
      * A map of glyph name / code
      */
@@ -124,6 +157,9 @@ private:
 
     /** The default font style */
     static const StyleAttributes k_defaultStyle;
+
+    /** The maximum number of cached text extents before the cache is emptied */
+    static const int k_textExtentCacheMaxEntryCount;
 };
 
 } // namespace vrv
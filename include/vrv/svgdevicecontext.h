@@ -73,6 +73,24 @@ public:
      */
     std::string GetStringSVG(bool xml_declaration = false);
 
+    /**
+     * Write the SVG to a pugi::xml_writer.
+     * The output is passed to the writer in chunks and is never held in full in memory.
+     * Add the xml tag if necessary.
+     */
+    void WriteSVG(pugi::xml_writer &writer, bool xml_declaration = false);
+
+    /**
+     * Return the glyphs from the smufl font used so far
+     */
+    const std::set<const Glyph *> &GetSmuflGlyphs() const { return m_smuflGlyphs; }
+
+    /**
+     * Get the SVG of a sprite file with the glyphs as symbols.
+     * The symbol IDs are the glyph codes, as referenced by the pages rendered with a glyph sprite.
+     */
+    static std::string GetGlyphSpriteSVG(const std::vector<const Glyph *> &glyphs, int indent, bool formatRaw);
+
     /**
      * @name Drawing methods
      */
@@ -222,6 +240,22 @@ public:
      */
     void SetRemoveXlink(bool removeXlink) { m_removeXlink = removeXlink; }
 
+    /**
+     * Reference the glyphs in an external sprite file instead of including them in the <defs> (empty by default)
+     */
+    void SetGlyphSprite(const std::string &glyphSprite) { m_glyphSprite = glyphSprite; }
+
+    /**
+     * Set the compact output, with sizes without units and fractional values without trailing zeros
+     * (false by default)
+     */
+    void SetCompact(bool compact) { m_compact = compact; }
+
+    /**
+     * Remove the ids and the classes not used by the styling, for non-interactive output (false by default)
+     */
+    void SetStripIds(bool stripIds) { m_stripIds = stripIds; }
+
     /**
      * Setter for an additional CSS
      */
@@ -279,11 +313,21 @@ private:
     void IncludeTextFont(const std::string &fontname, const Resources *resources);
 
     /**
-     * Flush the data to the internal buffer.
+     * Finalize the SVG document before it is written.
      * Adds the xml tag if necessary and the <defs> from m_smuflGlyphs
      */
     void Commit(bool xml_declaration);
 
+    /**
+     * Copy the symbol of the glyph to the <defs> node, adding the postfix (if any) to its ID
+     */
+    static void AppendGlyphSymbol(pugi::xml_node defs, const Glyph *glyph, const std::string &postfixId);
+
+    /**
+     * Format a double value, with the trailing zeros removed in the compact output
+     */
+    std::string FormatDouble(double value) const;
+
     void WriteLine(std::string);
 
     std::string GetColour(int colour);
@@ -321,6 +365,7 @@ private:
     std::ostringstream m_outdata;
 
     bool m_committed; // did we flushed the file?
+    unsigned int m_outputFlags; // the pugixml flags set in Commit
     int m_originX, m_originY;
 
     // holds the list of glyphs from the smufl font used so far
@@ -355,6 +400,12 @@ private:
     int m_indent;
     // prefix to be added to font glyphs
     std::string m_glyphPostfixId;
+    // href of the external glyph sprite file (glyphs included in the <defs> when empty)
+    std::string m_glyphSprite;
+    // compact output
+    bool m_compact;
+    // remove the ids and the classes not used by the styling
+    bool m_stripIds;
     // embedding of the smufl text font
     option_SMUFLTEXTFONT m_smuflTextFont;
 };
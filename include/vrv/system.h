@@ -163,6 +163,13 @@ public:
      */
     void ConvertToUnCastOffMensuralSystem();
 
+    /**
+     * Calculate the system breaks of the measures of the system minimizing the demerits of the systems, and return
+     * the measures starting a new system. The scoreDef width is the one of the scoreDef at the beginning.
+     * Called from System::CastOffSystems with BREAKS_optimal.
+     */
+    std::set<const Measure *> CalcOptimalBreaks(const Doc *doc, int systemWidth, int scoreDefWidth);
+
     //----------//
     // Functors //
     //----------//
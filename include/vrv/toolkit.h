@@ -8,12 +8,18 @@
 #ifndef __VRV_TOOLKIT_H__
 #define __VRV_TOOLKIT_H__
 
+#include <map>
+#include <memory>
+#include <set>
 #include <string>
+#include <string_view>
 
 //----------------------------------------------------------------------------
 
 #include "doc.h"
 #include "docselection.h"
+#include "featureindex.h"
+#include "rendercache.h"
 #include "toolkitdef.h"
 #include "view.h"
 
@@ -21,8 +27,10 @@
 
 namespace vrv {
 
+class DisplayListDeviceContext;
 class EditorToolkit;
 class RuntimeClock;
+class SvgDeviceContext;
 
 /**
  * @defgroup nodoc Public methods that are not listed in the documentation
@@ -92,9 +100,22 @@ public:
     /**
      * Get the log content for the latest operation.
      *
-     * @return The log content as a string
+     * @param jsonOptions A stringified JSON object with the log options
+     * diagnostics: true or false; false by default - return a JSON object with the messages and the
+     * number of occurrences of each message code;
+     * @return The log content as a string or as a stringified JSON object
      */
-    std::string GetLog();
+    std::string GetLog(const std::string &jsonOptions = "");
+
+    /**
+     * Get the statistics of the internal caches.
+     *
+     * The render cache is enabled with the renderCacheSize option.
+     * The text extent cache is always enabled and is reset when the font or the options change.
+     *
+     * @return A stringified JSON object with the size, the number of entries, hits, misses and evictions
+     */
+    std::string GetCacheStatistics();
 
     /**
      * Return the version number.
@@ -126,6 +147,7 @@ public:
      * Load a file from the file system.
      *
      * Previously convert UTF16 files to UTF8 or extract files from MusicXML compressed files.
+     * The file is memory-mapped and, for XML files, parsed in place without intermediate copies.
      *
      * @remark nojs
      *
@@ -338,6 +360,22 @@ public:
      */
     std::string RenderData(const std::string &data, const std::string &jsonOptions);
 
+    /**
+     * Render the data in several transpositions.
+     *
+     * Each transposition is loaded, laid out and rendered with the current options on a separate thread.
+     * The output of each transposition is identical to the output of loading the data with the
+     * corresponding transpose option.
+     *
+     * @param data A string with the data (e.g., MEI data) to be loaded
+     * @param jsonOptions A stringified JSON object with the "transpositions" (an array of transpose option
+     * values), the output "format" ("svg", "mei", "midi" or "timemap"; default is "svg"), the optional "pageNo" for
+     * SVG (default is all pages) and the optional maximum number of "threads"
+     * @return A stringified JSON array with the output of each transposition, or an "error" for the ones that
+     * could not be loaded. The messages of all the transpositions are in the log.
+     */
+    std::string RenderTranspositions(const std::string &data, const std::string &jsonOptions);
+
     /**
      * Render a page to SVG.
      *
@@ -358,6 +396,49 @@ public:
      */
     bool RenderToSVGFile(const std::string &filename, int pageNo = 1);
 
+    /**
+     * Render a page to SVGZ (gzip compressed SVG) as raw bytes.
+     *
+     * The SVG is compressed as it is written with the level given by the svgzLevel option.
+     *
+     * @remark nojs
+     *
+     * @param pageNo The page to render (1-based)
+     * @param xmlDeclaration True for including the xml declaration in the SVG output
+     * @return The SVGZ page as a string of bytes
+     */
+    std::string RenderToSVGZBuffer(int pageNo = 1, bool xmlDeclaration = false);
+
+    /**
+     * Render a page to SVGZ (gzip compressed SVG) and save it to the file.
+     *
+     * @remark nojs
+     *
+     * @param @filename The output filename
+     * @param @pageNo The page to render (1-based)
+     * @return True if the file was successfully written
+     */
+    bool RenderToSVGZFile(const std::string &filename, int pageNo = 1);
+
+    /**
+     * Render the glyph sprite referenced by the SVG pages when the svgGlyphSprite option is set.
+     *
+     * The sprite includes the glyphs of all the pages rendered since the data was loaded.
+     *
+     * @return The SVG sprite with the glyphs as symbols
+     */
+    std::string RenderToGlyphSprite();
+
+    /**
+     * Render the glyph sprite and save it to the file.
+     *
+     * @remark nojs
+     *
+     * @param @filename The output filename
+     * @return True if the file was successfully written
+     */
+    bool RenderToGlyphSpriteFile(const std::string &filename);
+
     /**
      * Render the document to MIDI.
      *
@@ -365,6 +446,15 @@ public:
      */
     std::string RenderToMIDI();
 
+    /**
+     * Render the document to MIDI as raw bytes.
+     *
+     * @remark nojs
+     *
+     * @return A MIDI file as a string of bytes (not base64 encoded)
+     */
+    std::string RenderToMIDIBuffer();
+
     /**
      * Render a document to MIDI and save it to the file.
      *
@@ -492,6 +582,19 @@ public:
      */
     bool SaveFile(const std::string &filename, const std::string &jsonOptions = "");
 
+    /**
+     * Save the binary snapshot of the document as imported to the file.
+     *
+     * The snapshot is kept only when the output is set to "snapshot" before loading the data.
+     * It is loaded like any other file and restores the document without parsing the original data.
+     *
+     * @remark nojs
+     *
+     * @param filename The output filename
+     * @return True if the file was successfully written
+     */
+    bool SaveSnapshot(const std::string &filename);
+
     ///@}
 
     /**
@@ -511,6 +614,43 @@ public:
      */
     std::string GetDescriptiveFeatures(const std::string &options);
 
+    /**
+     * Add the descriptive features of the loaded document to the feature index.
+     *
+     * The index holds melodic n-grams of many documents for incipit search.
+     *
+     * @param name The name of the document returned in the query results
+     * @return True if the document was successfully added
+     */
+    bool AddToFeatureIndex(const std::string &name);
+
+    /**
+     * Load a feature index file for queries.
+     *
+     * The file is memory-mapped and replaces the documents previously added.
+     *
+     * @param filename The name of the index file
+     * @return True if the file was successfully loaded
+     */
+    bool LoadFeatureIndex(const std::string &filename);
+
+    /**
+     * Return the matches of a melodic pattern in the feature index as a JSON string.
+     *
+     * @param query A stringified JSON object with "intervals", "intervalsDiatonic" or "contour" and an optional
+     * "limit"
+     * @return A stringified JSON object with the documents and note IDs matching the pattern
+     */
+    std::string QueryFeatureIndex(const std::string &query);
+
+    /**
+     * Write the feature index to a file.
+     *
+     * @param filename The name of the index file
+     * @return True if the file was successfully written
+     */
+    bool SaveFeatureIndex(const std::string &filename);
+
     /**
      * Return array of IDs of elements being currently played.
      *
@@ -634,6 +774,7 @@ public:
 
     /**
      * Render the page to the deviceContext.
+     * The page is drawn once in a display list that is replayed for the following renderings of the page.
      *
      * Page number is 1-based.
      *
@@ -664,6 +805,22 @@ public:
      */
     const char *GetCString();
 
+    /**
+     * Move the data to the binary internal buffer.
+     *
+     * @ingroup nodoc
+     */
+    void SetCBuffer(std::string &&data);
+
+    /**
+     * Return the content of the binary internal buffer and set its length.
+     *
+     * The buffer is not null-terminated and remains valid until the next call to SetCBuffer.
+     *
+     * @ingroup nodoc
+     */
+    const unsigned char *GetCBuffer(int *length);
+
     /**
      * Write the Humdrum buffer to the outputstream.
      *
@@ -730,20 +887,30 @@ protected:
     /**
      * Identify the input file type for auto loading of input data
      */
-    FileFormat IdentifyInputFrom(const std::string &data);
+    FileFormat IdentifyInputFrom(std::string_view data);
 
     /**
-     * Resets the vrv::logBuffer.
+     * Resets the vrv::logBuffer (unless the toolkit is a worker of another one).
      */
     void ResetLogBuffer();
 
 private:
     bool SetFont(const std::string &fontName);
-    bool IsUTF16(const std::string &filename);
-    bool LoadUTF16File(const std::string &filename);
-    bool IsZip(const std::string &filename);
-    bool LoadZipFile(const std::string &filename);
-    bool LoadZipData(const std::vector<unsigned char> &bytes);
+    bool IsUTF16(std::string_view data);
+    bool LoadUTF16Data(std::string_view data);
+    bool IsZip(std::string_view data);
+
+    /**
+     * Load the root file of a compressed MusicXML archive from a non-owning buffer.
+     * The file is inflated directly into the buffer parsed by the importer.
+     */
+    bool LoadZipData(std::string_view data);
+
+    /**
+     * Load data from a non-owning buffer.
+     * When inPlace is true, the buffer is writable and is modified by XML importers parsing it in place.
+     */
+    bool LoadBuffer(std::string_view data, bool inPlace);
     void GetClassIds(const std::vector<std::string> &classStrings, std::vector<ClassId> &classIds);
 
     /**
@@ -754,6 +921,46 @@ private:
      */
     std::string GetOptions(bool defaultValues) const;
 
+    /**
+     * Write the MEI to a stream with the output options of GetMEI.
+     */
+    bool WriteMEI(std::ostream &stream, const std::string &jsonOptions);
+
+    /**
+     * Render a page to the SVG device context with the SVG options.
+     */
+    void RenderToSvgDeviceContext(int pageNo, SvgDeviceContext *svg);
+
+    /**
+     * Write a page as SVGZ to a stream.
+     * The SVG is deflated while it is serialized and the uncompressed output is never held in full in memory.
+     */
+    bool WriteSVGZ(std::ostream &stream, int pageNo, bool xmlDeclaration);
+
+    /**
+     * Write the document as a MIDI file to a stream.
+     * The log buffer is not reset.
+     */
+    void WriteMIDI(std::ostream &stream);
+
+    /**
+     * Return the key for an output in the render cache.
+     * The key includes a checksum of the current options since these can be modified directly.
+     * Return an empty string when the cache is disabled.
+     */
+    std::string GetRenderCacheKey(RenderCacheType type, int pageNo, const std::string &params = "");
+
+    /**
+     * Return a checksum of the current options.
+     */
+    unsigned int GetOptionsChecksum() const;
+
+    /**
+     * Return the display list of a page (0-based) for the device context, recording it if necessary.
+     * The display lists are discarded when the options or the structure of the document change.
+     */
+    DisplayListDeviceContext *GetDisplayList(int pageIdx, DeviceContext *deviceContext);
+
 public:
     //
 private:
@@ -767,11 +974,41 @@ private:
 
     bool m_skipLayoutOnLoad;
 
+    /** False for the worker toolkits of RenderTranspositions that must not clear the shared log buffer */
+    bool m_resetsLogBuffer;
+
+    /** The cache of rendered output, the checksum of the loaded data and the doc structure generation */
+    RenderCache m_renderCache;
+    unsigned int m_dataChecksum;
+    unsigned int m_renderCacheGeneration;
+
+    /**
+     * The display lists of the pages already drawn, and the checksum of the options and the doc structure
+     * generation they were recorded with
+     */
+    std::map<int, std::unique_ptr<DisplayListDeviceContext>> m_displayLists;
+    unsigned int m_displayListsChecksum;
+    unsigned int m_displayListsGeneration;
+
+    /** The codes of the glyphs referenced by the SVG pages rendered with a glyph sprite */
+    std::set<std::string> m_glyphSpriteCodes;
+
+    /** The index of melodic n-grams for incipit search */
+    FeatureIndex m_featureIndex;
+
+    /** The snapshot of the document as imported (only with the snapshot output) */
+    std::string m_snapshot;
+
     /**
      * The C buffer string.
      */
     char *m_cString;
 
+    /**
+     * The binary buffer returned through the C API.
+     */
+    std::string m_cBuffer;
+
     EditorToolkit *m_editorToolkit;
 
 #ifndef NO_RUNTIME
@@ -26,7 +26,9 @@ enum FileFormat {
     MUSEDATAHUM,
     ESAC,
     MIDI,
-    TIMEMAP
+    TIMEMAP,
+    FEATUREINDEX,
+    SNAPSHOT
 };
 
 enum { LOG_OFF = 0, LOG_ERROR, LOG_WARNING, LOG_INFO, LOG_DEBUG };
@@ -137,6 +137,68 @@ private:
     System *m_system;
 };
 
+//----------------------------------------------------------------------------
+// Skyline
+//----------------------------------------------------------------------------
+
+/**
+ * This class is a piecewise-constant envelope over x of the values of horizontal segments.
+ * The segments are open intervals, which means that segments only touching each other do not overlap.
+ * It is used for calculating the overlap between the boxes of two staves in linear time instead of
+ * comparing every pair of boxes.
+ */
+class Skyline {
+public:
+    /**
+     * @name Constructors, destructors, and other standard methods
+     */
+    ///@{
+    Skyline() = default;
+    ~Skyline() = default;
+    ///@}
+
+    /**
+     * Add a segment with its value.
+     * The left position must be smaller than the right one.
+     */
+    void AddSegment(int left, int right, int value);
+
+    /**
+     * Calculate the envelope once all the segments have been added.
+     * The envelope holds the maximum value of the segments for each interval.
+     */
+    void CalcEnvelope();
+
+    /**
+     * Return the maximum sum of the values of the two envelopes where they overlap.
+     * Return VRV_UNSET if they do not overlap.
+     */
+    static int GetMaxSum(const Skyline &skyline1, const Skyline &skyline2);
+
+private:
+    /**
+     * A segment or an interval of the envelope
+     */
+    struct Segment {
+        int m_left;
+        int m_right;
+        int m_value;
+    };
+
+    /**
+     * Add an interval to the envelope
+     */
+    void AddInterval(int left, int right, int value);
+
+public:
+    //
+private:
+    /** The segments added */
+    std::vector<Segment> m_segments;
+    /** The envelope, with sorted and non-overlapping intervals */
+    std::vector<Segment> m_envelope;
+};
+
 //----------------------------------------------------------------------------
 // StaffAlignment
 //----------------------------------------------------------------------------
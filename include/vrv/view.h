@@ -8,6 +8,7 @@
 #ifndef __VRV_RENDERER_H__
 #define __VRV_RENDERER_H__
 
+#include <memory>
 #include <optional>
 
 #include "devicecontextbase.h"
@@ -49,10 +50,12 @@ class Layer;
 class LayerElement;
 class Lb;
 class Measure;
+class MetricParams;
 class MNum;
 class Mordent;
 class Nc;
 class Neume;
+class Note;
 class Num;
 class Octave;
 class Options;
@@ -67,6 +70,7 @@ class PgHead2;
 class PitchInflection;
 class Reh;
 class Rend;
+class Rest;
 class RunningElement;
 class Slur;
 class Staff;
@@ -298,6 +302,18 @@ protected:
     void DrawLayerElement(DeviceContext *dc, LayerElement *element, Layer *layer, Staff *staff, Measure *measure);
     ///@}
 
+    /**
+     * @name Method for calculating the bounding boxes of LayerElement directly from the glyph metrics.
+     * It is used in place of the drawing for notes and rests (and their accidentals, stems, flags and dots)
+     * when the bounding boxes are only calculated for the horizontal layout. It yields the same values as the
+     * BBoxDeviceContext and returns false when the element needs to be drawn.
+     * Defined in view_metric.cpp
+     */
+    ///@{
+    bool DrawLayerElementMetrics(
+        DeviceContext *dc, LayerElement *element, Layer *layer, Staff *staff, Measure *measure);
+    ///@}
+
     /**
      * @name Methods for drawing LayerElement child classes.
      * They are base drawing methods that are called directly from DrawLayerElement
@@ -636,6 +652,23 @@ private:
      */
     data_STEMDIRECTION GetMensuralStemDir(Layer *layer, Note *note, int verticalCenter);
 
+    /**
+     * Internal methods for calculating the bounding boxes from the glyph metrics.
+     * See DrawLayerElementMetrics
+     */
+    ///@{
+    bool IsMetricSupported(LayerElement *element, Staff *staff);
+    void CalcMetricElement(MetricParams &params, LayerElement *element, Staff *staff);
+    void CalcMetricNote(MetricParams &params, Note *note, Staff *staff);
+    void CalcMetricRest(MetricParams &params, Rest *rest, Staff *staff);
+    void CalcMetricGlyphs(MetricParams &params, int x, int y, const std::u32string &text, int staffSize, bool dimin,
+        bool setBBGlyph, bool centered = false);
+    void CalcMetricLine(MetricParams &params, int x1, int y1, int x2, int y2, int width, bool updateX = true);
+    void CalcMetricDots(MetricParams &params, int x, int y, unsigned char dots, const Staff *staff, bool dimin);
+    void UpdateMetricBB(
+        MetricParams &params, int x1, int y1, int x2, int y2, bool updateX, char32_t glyph = 0, int pointSize = 0);
+    ///@}
+
 public:
     /** Document */
     Doc *m_doc;
@@ -677,6 +710,20 @@ protected:
      */
     ScoreDef m_drawingScoreDef;
 
+    /**
+     * @name Objects drawn for elements that do not exist as such in the document (e.g., lyric connectors).
+     * They are owned by the View (and not temporary) because device contexts such as the display list
+     * keep pointers to the objects drawn.
+     */
+    ///@{
+    std::unique_ptr<F> m_fConnector;
+    std::unique_ptr<Syl> m_sylConnector;
+    std::unique_ptr<Text> m_endingText;
+    ///@}
+
+    /** The element being drawn for checking the bounding boxes calculated from the glyph metrics */
+    LayerElement *m_metricCheckElement;
+
 private:
     //----------------//
     // Static members //
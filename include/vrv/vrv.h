@@ -14,6 +14,7 @@
 #include <stdio.h>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #ifndef _WIN32
@@ -41,10 +42,24 @@ void LogWarning(const char *fmt, ...);
 
 /**
  * Member and functions specific to loging that uses a vector of string to buffer the logs.
+ * The buffer keeps up to LOG_BUFFER_MAX_SIZE unique messages, looked up through a hash set.
+ * Every message is also counted by its code (its format string), including once the buffer is full.
  */
-extern std::vector<std::string> logBuffer;
+struct LogCodeCount {
+    LogLevel m_level;
+    int m_count;
+};
 bool LogBufferContains(const std::string &s);
+bool LogBufferCount(const char *fmt, LogLevel level);
 void LogString(std::string message, LogLevel level);
+void ClearLogBuffer();
+
+/**
+ * Return a copy of the buffered messages and of the code counts (sorted by code).
+ * The copies are made under the log buffer mutex since other threads can be logging.
+ */
+std::vector<std::string> GetLogBuffer();
+std::vector<std::pair<std::string, LogCodeCount>> GetLogCodeCounts();
 
 /**
  * Convert a string to a logLevel
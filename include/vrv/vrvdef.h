@@ -268,6 +268,7 @@ enum ClassId : uint16_t {
     //
     BBOX_DEVICE_CONTEXT,
     SVG_DEVICE_CONTEXT,
+    DISPLAYLIST_DEVICE_CONTEXT,
     CUSTOM_DEVICE_CONTEXT,
     //
     UNSPECIFIED
@@ -423,6 +424,10 @@ typedef std::map<int, LayerN_VerserN_t> StaffN_LayerN_VerseN_t;
 
 #define durRound(dur) round(dur *pow(10, 8)) / pow(10, 8)
 
+/** The range of the SMuFL codes (Unicode Private Use Area) **/
+#define SMUFL_CODE_FIRST 0xE000
+#define SMUFL_CODE_LAST 0xF8FF
+
 /**
  * Codes returned by Functors.
  * Default is FUNCTOR_CONTINUE.
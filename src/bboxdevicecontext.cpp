@@ -451,6 +451,16 @@ void BBoxDeviceContext::UpdateBB(int x1, int y1, int x2, int y2, char32_t glyph)
     }
 }
 
+void BBoxDeviceContext::UpdateContentBB(int x1, int y1, int x2, int y2, bool updateX, bool updateY)
+{
+    for (Object *object : m_objects) {
+        if (updateX) object->UpdateContentBBoxX(x1, x2);
+        if (updateY) object->UpdateContentBBoxY(y1, y2);
+    }
+
+    this->ResetGraphicRotation();
+}
+
 void BBoxDeviceContext::ResetGraphicRotation()
 {
     m_rotationAngle = 0.0;
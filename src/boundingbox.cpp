@@ -588,7 +588,7 @@ int BoundingBox::Intersects(const FloatingCurvePositioner *curve, Accessor type,
     if (p1.x > this->GetRightBy(type)) return 0;
 
     Point topBezier[4], bottomBezier[4];
-    BoundingBox::CalcThickBezier(points, curve->GetThickness(), topBezier, bottomBezier);
+    curve->GetThickBezier(topBezier, bottomBezier);
 
     // The curve overflows on both sides
     if ((p1.x < this->GetLeftBy(type)) && p2.x > this->GetRightBy(type)) {
@@ -842,19 +842,21 @@ double BoundingBox::CalcBezierParamAtPosition(const Point bezier[4], int x)
     const double d = bezier[0].x - x;
 
     // Solve the polynomial
-    const std::set<double> roots = BoundingBox::SolveCubicPolynomial(a, b, c, d);
+    double roots[3];
+    const int rootCount = BoundingBox::SolveCubicPolynomial(a, b, c, d, roots);
 
-    // Return the first root in [0,1]
-    auto iter = std::find_if(roots.begin(), roots.end(), [](double value) {
-        constexpr double eps = 1e-6; // Numerical freedom
-        return ((value >= -eps) && (value <= 1.0 + eps));
-    });
+    // Return the smallest root in [0,1]
+    constexpr double eps = 1e-6; // Numerical freedom
+    bool found = false;
     double root = 0.0;
-    if (iter != roots.end()) {
-        root = *iter;
-        root = std::max(root, 0.0);
-        root = std::min(root, 1.0);
+    for (int i = 0; i < rootCount; ++i) {
+        // This also skips NaN roots
+        if (!((roots[i] >= -eps) && (roots[i] <= 1.0 + eps))) continue;
+        if (!found || (roots[i] < root)) root = roots[i];
+        found = true;
     }
+    root = std::max(root, 0.0);
+    root = std::min(root, 1.0);
     return root;
 }
 
@@ -914,6 +916,13 @@ Point BoundingBox::CalcDeCasteljau(const Point bezier[4], double t)
 }
 
 std::set<double> BoundingBox::SolveCubicPolynomial(double a, double b, double c, double d)
+{
+    double roots[3];
+    const int rootCount = BoundingBox::SolveCubicPolynomial(a, b, c, d, roots);
+    return std::set<double>(roots, roots + rootCount);
+}
+
+int BoundingBox::SolveCubicPolynomial(double a, double b, double c, double d, double roots[3])
 {
     // Implementation of Cardano's algorithm
     // See https://pomax.github.io/bezierinfo/#extremities
@@ -924,14 +933,17 @@ std::set<double> BoundingBox::SolveCubicPolynomial(double a, double b, double c,
         if (abs(b) < 10e-10) {
             // This is not a quadratic curve either.
             if (abs(c) < 10e-10) {
-                return {};
+                return 0;
             }
             // Linear solution
-            return { -d / c };
+            roots[0] = -d / c;
+            return 1;
         }
         // Quadratic solution
         const double q = sqrt(c * c - 4.0 * b * d);
-        return { (q - c) / (2.0 * b), (-c - q) / (2.0 * b) };
+        roots[0] = (q - c) / (2.0 * b);
+        roots[1] = (-c - q) / (2.0 * b);
+        return 2;
     }
 
     // We know that we need a cubic solution.
@@ -953,25 +965,26 @@ std::set<double> BoundingBox::SolveCubicPolynomial(double a, double b, double c,
         const double cosphi = (t < -1.0) ? -1.0 : ((t > 1.0) ? 1.0 : t);
         const double phi = acos(cosphi);
         const double u = 2.0 * cbrt(r);
-        const double root1 = u * cos(phi / 3.0) - b / 3.0;
-        const double root2 = u * cos((phi + 2.0 * M_PI) / 3.0) - b / 3.0;
-        const double root3 = u * cos((phi + 4.0 * M_PI) / 3.0) - b / 3.0;
-        return { root1, root2, root3 };
+        roots[0] = u * cos(phi / 3.0) - b / 3.0;
+        roots[1] = u * cos((phi + 2.0 * M_PI) / 3.0) - b / 3.0;
+        roots[2] = u * cos((phi + 4.0 * M_PI) / 3.0) - b / 3.0;
+        return 3;
     }
 
     if (discriminant == 0.0) {
         // three real roots, but two of them are equal
         const double u = -cbrt(q2);
-        const double root1 = 2.0 * u - b / 3.0;
-        const double root2 = -u - b / 3.0;
-        return { root1, root2 };
+        roots[0] = 2.0 * u - b / 3.0;
+        roots[1] = -u - b / 3.0;
+        return 2;
     }
 
     // one real root, two complex roots
     const double sd = sqrt(discriminant);
     const double u = cbrt(sd - q2);
     const double v = cbrt(sd + q2);
-    return { u - v - b / 3.0 };
+    roots[0] = u - v - b / 3.0;
+    return 1;
 }
 
 void BoundingBox::CalcThickBezier(const Point bezier[4], int thickness, Point topBezier[4], Point bottomBezier[4])
@@ -241,6 +241,28 @@ void DeviceContext::GetTextExtent(const std::u32string &string, TextExtend *exte
     const Resources *resources = this->GetResources();
     assert(resources);
 
+    const int pointSize = m_fontStack.top()->GetPointSize();
+    const TextExtend *cached = resources->GetCachedTextExtent(string, pointSize, typeSize);
+    if (!cached) {
+        // Calculate the extent from scratch so the ascent and descent do not depend on the values passed in
+        TextExtend textExtend;
+        textExtend.m_ascent = VRV_UNSET;
+        textExtend.m_descent = VRV_UNSET;
+        this->CalcTextExtent(string, &textExtend, typeSize);
+        cached = resources->CacheTextExtent(string, pointSize, typeSize, textExtend);
+    }
+
+    extend->m_width = cached->m_width;
+    extend->m_height = cached->m_height;
+    extend->m_ascent = std::max(cached->m_ascent, extend->m_ascent);
+    extend->m_descent = std::max(cached->m_descent, extend->m_descent);
+}
+
+void DeviceContext::CalcTextExtent(const std::u32string &string, TextExtend *extend, bool typeSize)
+{
+    const Resources *resources = this->GetResources();
+    assert(resources);
+
     extend->m_width = 0;
     extend->m_height = 0;
 
@@ -0,0 +1,593 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        displaylistdevicecontext.cpp
+// Author:      Laurent Pugin
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "displaylistdevicecontext.h"
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cassert>
+
+//----------------------------------------------------------------------------
+
+#include "vrv.h"
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// Static methods for comparing the state
+//----------------------------------------------------------------------------
+
+static bool IsSamePen(const Pen &pen1, const Pen &pen2)
+{
+    return ((pen1.GetColour() == pen2.GetColour()) && (pen1.GetWidth() == pen2.GetWidth())
+        && (pen1.GetDashLength() == pen2.GetDashLength()) && (pen1.GetGapLength() == pen2.GetGapLength())
+        && (pen1.GetLineCap() == pen2.GetLineCap()) && (pen1.GetLineJoin() == pen2.GetLineJoin())
+        && (pen1.GetOpacity() == pen2.GetOpacity()));
+}
+
+static bool IsSameBrush(const Brush &brush1, const Brush &brush2)
+{
+    return ((brush1.GetColour() == brush2.GetColour()) && (brush1.GetOpacity() == brush2.GetOpacity()));
+}
+
+static bool IsSameFont(const FontInfo &font1, const FontInfo &font2)
+{
+    return ((font1.GetPointSize() == font2.GetPointSize()) && (font1.GetFamily() == font2.GetFamily())
+        && (font1.GetStyle() == font2.GetStyle()) && (font1.GetWeight() == font2.GetWeight())
+        && (font1.GetUnderlined() == font2.GetUnderlined()) && (font1.GetSupSubScript() == font2.GetSupSubScript())
+        && (font1.GetEncoding() == font2.GetEncoding())
+        && (font1.GetWidthToHeightRatio() == font2.GetWidthToHeightRatio())
+        && (font1.GetSmuflFont() == font2.GetSmuflFont()) && (font1.GetFaceName() == font2.GetFaceName()));
+}
+
+//----------------------------------------------------------------------------
+// DisplayListDeviceContext
+//----------------------------------------------------------------------------
+
+DisplayListDeviceContext::DisplayListDeviceContext(bool useGlobalStyling) : DeviceContext(DISPLAYLIST_DEVICE_CONTEXT)
+{
+    m_useGlobalStyling = useGlobalStyling;
+
+    m_currentPen = VRV_UNSET;
+    m_currentBrush = VRV_UNSET;
+    m_currentFont = VRV_UNSET;
+    m_currentDeactivatedX = false;
+    m_currentDeactivatedY = false;
+}
+
+DisplayListDeviceContext::~DisplayListDeviceContext() {}
+
+DisplayListDeviceContext::DisplayListCommand &DisplayListDeviceContext::AddCommand(DisplayListCommandType type)
+{
+    DisplayListCommand command;
+    command.m_type = type;
+    command.m_object = NULL;
+    command.m_view = NULL;
+    command.m_deactivatedX = m_isDeactivatedX;
+    command.m_deactivatedY = m_isDeactivatedY;
+
+    // The state is stored only when it changes from the one of the previous command
+    command.m_pen = VRV_UNSET;
+    if (!m_penStack.empty()) {
+        if (m_pens.empty() || !IsSamePen(m_pens.back(), m_penStack.top())) m_pens.push_back(m_penStack.top());
+        command.m_pen = (int)m_pens.size() - 1;
+    }
+    command.m_brush = VRV_UNSET;
+    if (!m_brushStack.empty()) {
+        if (m_brushes.empty() || !IsSameBrush(m_brushes.back(), m_brushStack.top())) {
+            m_brushes.push_back(m_brushStack.top());
+        }
+        command.m_brush = (int)m_brushes.size() - 1;
+    }
+    // Fonts are pointers to objects owned by the View and have to be copied
+    command.m_font = VRV_UNSET;
+    if (!m_fontStack.empty()) {
+        if (m_fonts.empty() || !IsSameFont(m_fonts.back(), *m_fontStack.top())) m_fonts.push_back(*m_fontStack.top());
+        command.m_font = (int)m_fonts.size() - 1;
+    }
+
+    m_commands.push_back(command);
+    return m_commands.back();
+}
+
+int DisplayListDeviceContext::AddString(const std::string &string)
+{
+    m_strings.push_back(string);
+    return (int)m_strings.size() - 1;
+}
+
+int DisplayListDeviceContext::AddText(const std::u32string &text)
+{
+    m_texts.push_back(text);
+    return (int)m_texts.size() - 1;
+}
+
+int DisplayListDeviceContext::AddPoints(int n, const Point points[])
+{
+    const int offset = (int)m_points.size();
+    m_points.insert(m_points.end(), points, points + n);
+    return offset;
+}
+
+void DisplayListDeviceContext::SetBackground(int colour, int style)
+{
+    DisplayListCommand &command = this->AddCommand(DL_SET_BACKGROUND);
+    command.m_args[0] = colour;
+    command.m_args[1] = style;
+}
+
+void DisplayListDeviceContext::SetBackgroundImage(void *image, double opacity)
+{
+    DisplayListCommand &command = this->AddCommand(DL_SET_BACKGROUND_IMAGE);
+    m_images.push_back(image);
+    command.m_args[0] = (int)m_images.size() - 1;
+    command.m_values[0] = opacity;
+}
+
+void DisplayListDeviceContext::SetBackgroundMode(int mode)
+{
+    DisplayListCommand &command = this->AddCommand(DL_SET_BACKGROUND_MODE);
+    command.m_args[0] = mode;
+}
+
+void DisplayListDeviceContext::SetTextForeground(int colour)
+{
+    DisplayListCommand &command = this->AddCommand(DL_SET_TEXT_FOREGROUND);
+    command.m_args[0] = colour;
+}
+
+void DisplayListDeviceContext::SetTextBackground(int colour)
+{
+    DisplayListCommand &command = this->AddCommand(DL_SET_TEXT_BACKGROUND);
+    command.m_args[0] = colour;
+}
+
+void DisplayListDeviceContext::SetLogicalOrigin(int x, int y)
+{
+    DisplayListCommand &command = this->AddCommand(DL_SET_LOGICAL_ORIGIN);
+    command.m_args[0] = x;
+    command.m_args[1] = y;
+    m_origin = Point(x, y);
+}
+
+Point DisplayListDeviceContext::GetLogicalOrigin()
+{
+    return m_origin;
+}
+
+void DisplayListDeviceContext::DrawQuadBezierPath(Point bezier[3])
+{
+    DisplayListCommand &command = this->AddCommand(DL_DRAW_QUAD_BEZIER_PATH);
+    command.m_args[0] = this->AddPoints(3, bezier);
+}
+
+void DisplayListDeviceContext::DrawCubicBezierPath(Point bezier[4])
+{
+    DisplayListCommand &command = this->AddCommand(DL_DRAW_CUBIC_BEZIER_PATH);
+    command.m_args[0] = this->AddPoints(4, bezier);
+}
+
+void DisplayListDeviceContext::DrawCubicBezierPathFilled(Point bezier1[4], Point bezier2[4])
+{
+    DisplayListCommand &command = this->AddCommand(DL_DRAW_CUBIC_BEZIER_PATH_FILLED);
+    command.m_args[0] = this->AddPoints(4, bezier1);
+    this->AddPoints(4, bezier2);
+}
+
+void DisplayListDeviceContext::DrawCircle(int x, int y, int radius)
+{
+    DisplayListCommand &command = this->AddCommand(DL_DRAW_CIRCLE);
+    command.m_args[0] = x;
+    command.m_args[1] = y;
+    command.m_args[2] = radius;
+}
+
+void DisplayListDeviceContext::DrawEllipse(int x, int y, int width, int height)
+{
+    DisplayListCommand &command = this->AddCommand(DL_DRAW_ELLIPSE);
+    command.m_args[0] = x;
+    command.m_args[1] = y;
+    command.m_args[2] = width;
+    command.m_args[3] = height;
+}
+
+void DisplayListDeviceContext::DrawEllipticArc(int x, int y, int width, int height, double start, double end)
+{
+    DisplayListCommand &command = this->AddCommand(DL_DRAW_ELLIPTIC_ARC);
+    command.m_args[0] = x;
+    command.m_args[1] = y;
+    command.m_args[2] = width;
+    command.m_args[3] = height;
+    command.m_values[0] = start;
+    command.m_values[1] = end;
+}
+
+void DisplayListDeviceContext::DrawLine(int x1, int y1, int x2, int y2)
+{
+    DisplayListCommand &command = this->AddCommand(DL_DRAW_LINE);
+    command.m_args[0] = x1;
+    command.m_args[1] = y1;
+    command.m_args[2] = x2;
+    command.m_args[3] = y2;
+}
+
+void DisplayListDeviceContext::DrawPolyline(int n, Point points[], int xOffset, int yOffset)
+{
+    DisplayListCommand &command = this->AddCommand(DL_DRAW_POLYLINE);
+    command.m_args[0] = this->AddPoints(n, points);
+    command.m_args[1] = n;
+    command.m_args[2] = xOffset;
+    command.m_args[3] = yOffset;
+}
+
+void DisplayListDeviceContext::DrawPolygon(int n, Point points[], int xOffset, int yOffset)
+{
+    DisplayListCommand &command = this->AddCommand(DL_DRAW_POLYGON);
+    command.m_args[0] = this->AddPoints(n, points);
+    command.m_args[1] = n;
+    command.m_args[2] = xOffset;
+    command.m_args[3] = yOffset;
+}
+
+void DisplayListDeviceContext::DrawRectangle(int x, int y, int width, int height)
+{
+    DisplayListCommand &command = this->AddCommand(DL_DRAW_RECTANGLE);
+    command.m_args[0] = x;
+    command.m_args[1] = y;
+    command.m_args[2] = width;
+    command.m_args[3] = height;
+}
+
+void DisplayListDeviceContext::DrawRotatedText(const std::string &text, int x, int y, double angle)
+{
+    DisplayListCommand &command = this->AddCommand(DL_DRAW_ROTATED_TEXT);
+    command.m_args[0] = this->AddString(text);
+    command.m_args[1] = x;
+    command.m_args[2] = y;
+    command.m_values[0] = angle;
+}
+
+void DisplayListDeviceContext::DrawRoundedRectangle(int x, int y, int width, int height, int radius)
+{
+    DisplayListCommand &command = this->AddCommand(DL_DRAW_ROUNDED_RECTANGLE);
+    command.m_args[0] = x;
+    command.m_args[1] = y;
+    command.m_args[2] = width;
+    command.m_args[3] = height;
+    command.m_args[4] = radius;
+}
+
+void DisplayListDeviceContext::DrawText(
+    const std::string &text, const std::u32string &wtext, int x, int y, int width, int height)
+{
+    DisplayListCommand &command = this->AddCommand(DL_DRAW_TEXT);
+    command.m_args[0] = this->AddString(text);
+    command.m_args[1] = this->AddText(wtext);
+    command.m_args[2] = x;
+    command.m_args[3] = y;
+    command.m_args[4] = width;
+    command.m_args[5] = height;
+}
+
+void DisplayListDeviceContext::DrawMusicText(const std::u32string &text, int x, int y, bool setSmuflGlyph)
+{
+    DisplayListCommand &command = this->AddCommand(DL_DRAW_MUSIC_TEXT);
+    command.m_args[0] = this->AddText(text);
+    command.m_args[1] = x;
+    command.m_args[2] = y;
+    command.m_args[3] = setSmuflGlyph;
+}
+
+void DisplayListDeviceContext::DrawSpline(int n, Point points[])
+{
+    DisplayListCommand &command = this->AddCommand(DL_DRAW_SPLINE);
+    command.m_args[0] = this->AddPoints(n, points);
+    command.m_args[1] = n;
+}
+
+void DisplayListDeviceContext::DrawGraphicUri(int x, int y, int width, int height, const std::string &uri)
+{
+    DisplayListCommand &command = this->AddCommand(DL_DRAW_GRAPHIC_URI);
+    command.m_args[0] = x;
+    command.m_args[1] = y;
+    command.m_args[2] = width;
+    command.m_args[3] = height;
+    command.m_args[4] = this->AddString(uri);
+}
+
+void DisplayListDeviceContext::DrawSvgShape(int x, int y, int width, int height, double scale, pugi::xml_node svg)
+{
+    DisplayListCommand &command = this->AddCommand(DL_DRAW_SVG_SHAPE);
+    command.m_args[0] = x;
+    command.m_args[1] = y;
+    command.m_args[2] = width;
+    command.m_args[3] = height;
+    command.m_values[0] = scale;
+    m_svgNodes.push_back(svg);
+    command.m_args[4] = (int)m_svgNodes.size() - 1;
+}
+
+void DisplayListDeviceContext::DrawBackgroundImage(int x, int y)
+{
+    DisplayListCommand &command = this->AddCommand(DL_DRAW_BACKGROUND_IMAGE);
+    command.m_args[0] = x;
+    command.m_args[1] = y;
+}
+
+void DisplayListDeviceContext::DrawPlaceholder(int x, int y)
+{
+    DisplayListCommand &command = this->AddCommand(DL_DRAW_PLACEHOLDER);
+    command.m_args[0] = x;
+    command.m_args[1] = y;
+}
+
+void DisplayListDeviceContext::StartText(int x, int y, data_HORIZONTALALIGNMENT alignment)
+{
+    DisplayListCommand &command = this->AddCommand(DL_START_TEXT);
+    command.m_args[0] = x;
+    command.m_args[1] = y;
+    command.m_args[2] = alignment;
+}
+
+void DisplayListDeviceContext::EndText()
+{
+    this->AddCommand(DL_END_TEXT);
+}
+
+void DisplayListDeviceContext::MoveTextTo(int x, int y, data_HORIZONTALALIGNMENT alignment)
+{
+    DisplayListCommand &command = this->AddCommand(DL_MOVE_TEXT_TO);
+    command.m_args[0] = x;
+    command.m_args[1] = y;
+    command.m_args[2] = alignment;
+}
+
+void DisplayListDeviceContext::MoveTextVerticallyTo(int y)
+{
+    DisplayListCommand &command = this->AddCommand(DL_MOVE_TEXT_VERTICALLY_TO);
+    command.m_args[0] = y;
+}
+
+void DisplayListDeviceContext::StartGraphic(
+    Object *object, std::string gClass, std::string gId, GraphicID graphicID, bool prepend)
+{
+    DisplayListCommand &command = this->AddCommand(DL_START_GRAPHIC);
+    command.m_object = object;
+    command.m_args[0] = this->AddString(gClass);
+    command.m_args[1] = this->AddString(gId);
+    command.m_args[2] = graphicID;
+    command.m_args[3] = prepend;
+}
+
+void DisplayListDeviceContext::EndGraphic(Object *object, View *view)
+{
+    DisplayListCommand &command = this->AddCommand(DL_END_GRAPHIC);
+    command.m_object = object;
+    command.m_view = view;
+}
+
+void DisplayListDeviceContext::StartCustomGraphic(std::string name, std::string gClass, std::string gId)
+{
+    DisplayListCommand &command = this->AddCommand(DL_START_CUSTOM_GRAPHIC);
+    command.m_args[0] = this->AddString(name);
+    command.m_args[1] = this->AddString(gClass);
+    command.m_args[2] = this->AddString(gId);
+}
+
+void DisplayListDeviceContext::EndCustomGraphic()
+{
+    this->AddCommand(DL_END_CUSTOM_GRAPHIC);
+}
+
+void DisplayListDeviceContext::ResumeGraphic(Object *object, std::string gId)
+{
+    DisplayListCommand &command = this->AddCommand(DL_RESUME_GRAPHIC);
+    command.m_object = object;
+    command.m_args[0] = this->AddString(gId);
+}
+
+void DisplayListDeviceContext::EndResumedGraphic(Object *object, View *view)
+{
+    DisplayListCommand &command = this->AddCommand(DL_END_RESUMED_GRAPHIC);
+    command.m_object = object;
+    command.m_view = view;
+}
+
+void DisplayListDeviceContext::StartTextGraphic(Object *object, std::string gClass, std::string gId)
+{
+    DisplayListCommand &command = this->AddCommand(DL_START_TEXT_GRAPHIC);
+    command.m_object = object;
+    command.m_args[0] = this->AddString(gClass);
+    command.m_args[1] = this->AddString(gId);
+}
+
+void DisplayListDeviceContext::EndTextGraphic(Object *object, View *view)
+{
+    DisplayListCommand &command = this->AddCommand(DL_END_TEXT_GRAPHIC);
+    command.m_object = object;
+    command.m_view = view;
+}
+
+void DisplayListDeviceContext::RotateGraphic(Point const &orig, double angle)
+{
+    DisplayListCommand &command = this->AddCommand(DL_ROTATE_GRAPHIC);
+    command.m_args[0] = orig.x;
+    command.m_args[1] = orig.y;
+    command.m_values[0] = angle;
+}
+
+void DisplayListDeviceContext::StartPage()
+{
+    this->AddCommand(DL_START_PAGE);
+}
+
+void DisplayListDeviceContext::EndPage()
+{
+    this->AddCommand(DL_END_PAGE);
+}
+
+void DisplayListDeviceContext::AddDescription(const std::string &text)
+{
+    DisplayListCommand &command = this->AddCommand(DL_ADD_DESCRIPTION);
+    command.m_args[0] = this->AddString(text);
+}
+
+void DisplayListDeviceContext::ApplyState(DeviceContext *dc, const DisplayListCommand &command)
+{
+    if (command.m_pen != m_currentPen) {
+        if (m_currentPen != VRV_UNSET) dc->ResetPen();
+        if (command.m_pen != VRV_UNSET) {
+            const Pen &pen = m_pens.at(command.m_pen);
+            // The dash and gap lengths are already resolved, so only the opacity has to be mapped back to a style
+            const int style = (pen.GetOpacity() == 0.0) ? AxTRANSPARENT : AxSOLID;
+            dc->SetPen(pen.GetColour(), pen.GetWidth(), style, pen.GetDashLength(), pen.GetGapLength(),
+                pen.GetLineCap(), pen.GetLineJoin());
+        }
+        m_currentPen = command.m_pen;
+    }
+    if (command.m_brush != m_currentBrush) {
+        if (m_currentBrush != VRV_UNSET) dc->ResetBrush();
+        if (command.m_brush != VRV_UNSET) {
+            const Brush &brush = m_brushes.at(command.m_brush);
+            dc->SetBrush(brush.GetColour(), (brush.GetOpacity() == 0.0) ? AxTRANSPARENT : AxSOLID);
+        }
+        m_currentBrush = command.m_brush;
+    }
+    if (command.m_font != m_currentFont) {
+        if (m_currentFont != VRV_UNSET) dc->ResetFont();
+        if (command.m_font != VRV_UNSET) dc->SetFont(&m_fonts.at(command.m_font));
+        m_currentFont = command.m_font;
+    }
+    if ((command.m_deactivatedX != m_currentDeactivatedX) || (command.m_deactivatedY != m_currentDeactivatedY)) {
+        if (m_currentDeactivatedX || m_currentDeactivatedY) dc->ReactivateGraphic();
+        if (command.m_deactivatedX && command.m_deactivatedY) {
+            dc->DeactivateGraphic();
+        }
+        else if (command.m_deactivatedX) {
+            dc->DeactivateGraphicX();
+        }
+        else if (command.m_deactivatedY) {
+            dc->DeactivateGraphicY();
+        }
+        m_currentDeactivatedX = command.m_deactivatedX;
+        m_currentDeactivatedY = command.m_deactivatedY;
+    }
+}
+
+void DisplayListDeviceContext::ResetState(DeviceContext *dc)
+{
+    if (m_currentPen != VRV_UNSET) dc->ResetPen();
+    if (m_currentBrush != VRV_UNSET) dc->ResetBrush();
+    if (m_currentFont != VRV_UNSET) dc->ResetFont();
+    if (m_currentDeactivatedX || m_currentDeactivatedY) dc->ReactivateGraphic();
+
+    m_currentPen = VRV_UNSET;
+    m_currentBrush = VRV_UNSET;
+    m_currentFont = VRV_UNSET;
+    m_currentDeactivatedX = false;
+    m_currentDeactivatedY = false;
+}
+
+void DisplayListDeviceContext::Replay(DeviceContext *dc)
+{
+    assert(dc);
+    assert(dc != this);
+
+    // Ensure that resources are set, as the View does when drawing
+    const bool dcHasResources = dc->HasResources();
+    if (!dcHasResources) dc->SetResources(this->GetResources());
+
+    dc->SetContentHeight(this->GetContentHeight());
+
+    Point points[4];
+    Point points2[4];
+
+    for (const DisplayListCommand &command : m_commands) {
+        this->ApplyState(dc, command);
+        const int *args = command.m_args;
+        switch (command.m_type) {
+            case DL_SET_BACKGROUND: dc->SetBackground(args[0], args[1]); break;
+            case DL_SET_BACKGROUND_IMAGE: dc->SetBackgroundImage(m_images.at(args[0]), command.m_values[0]); break;
+            case DL_SET_BACKGROUND_MODE: dc->SetBackgroundMode(args[0]); break;
+            case DL_SET_TEXT_FOREGROUND: dc->SetTextForeground(args[0]); break;
+            case DL_SET_TEXT_BACKGROUND: dc->SetTextBackground(args[0]); break;
+            case DL_SET_LOGICAL_ORIGIN: dc->SetLogicalOrigin(args[0], args[1]); break;
+            case DL_DRAW_QUAD_BEZIER_PATH:
+                std::copy(m_points.begin() + args[0], m_points.begin() + args[0] + 3, points);
+                dc->DrawQuadBezierPath(points);
+                break;
+            case DL_DRAW_CUBIC_BEZIER_PATH:
+                std::copy(m_points.begin() + args[0], m_points.begin() + args[0] + 4, points);
+                dc->DrawCubicBezierPath(points);
+                break;
+            case DL_DRAW_CUBIC_BEZIER_PATH_FILLED:
+                std::copy(m_points.begin() + args[0], m_points.begin() + args[0] + 4, points);
+                std::copy(m_points.begin() + args[0] + 4, m_points.begin() + args[0] + 8, points2);
+                dc->DrawCubicBezierPathFilled(points, points2);
+                break;
+            case DL_DRAW_CIRCLE: dc->DrawCircle(args[0], args[1], args[2]); break;
+            case DL_DRAW_ELLIPSE: dc->DrawEllipse(args[0], args[1], args[2], args[3]); break;
+            case DL_DRAW_ELLIPTIC_ARC:
+                dc->DrawEllipticArc(args[0], args[1], args[2], args[3], command.m_values[0], command.m_values[1]);
+                break;
+            case DL_DRAW_LINE: dc->DrawLine(args[0], args[1], args[2], args[3]); break;
+            case DL_DRAW_POLYLINE: dc->DrawPolyline(args[1], m_points.data() + args[0], args[2], args[3]); break;
+            case DL_DRAW_POLYGON: dc->DrawPolygon(args[1], m_points.data() + args[0], args[2], args[3]); break;
+            case DL_DRAW_RECTANGLE: dc->DrawRectangle(args[0], args[1], args[2], args[3]); break;
+            case DL_DRAW_ROTATED_TEXT:
+                dc->DrawRotatedText(m_strings.at(args[0]), args[1], args[2], command.m_values[0]);
+                break;
+            case DL_DRAW_ROUNDED_RECTANGLE:
+                dc->DrawRoundedRectangle(args[0], args[1], args[2], args[3], args[4]);
+                break;
+            case DL_DRAW_TEXT:
+                dc->DrawText(m_strings.at(args[0]), m_texts.at(args[1]), args[2], args[3], args[4], args[5]);
+                break;
+            case DL_DRAW_MUSIC_TEXT: dc->DrawMusicText(m_texts.at(args[0]), args[1], args[2], args[3]); break;
+            case DL_DRAW_SPLINE: dc->DrawSpline(args[1], m_points.data() + args[0]); break;
+            case DL_DRAW_GRAPHIC_URI:
+                dc->DrawGraphicUri(args[0], args[1], args[2], args[3], m_strings.at(args[4]));
+                break;
+            case DL_DRAW_SVG_SHAPE:
+                dc->DrawSvgShape(args[0], args[1], args[2], args[3], command.m_values[0], m_svgNodes.at(args[4]));
+                break;
+            case DL_DRAW_BACKGROUND_IMAGE: dc->DrawBackgroundImage(args[0], args[1]); break;
+            case DL_DRAW_PLACEHOLDER: dc->DrawPlaceholder(args[0], args[1]); break;
+            case DL_START_TEXT: dc->StartText(args[0], args[1], (data_HORIZONTALALIGNMENT)args[2]); break;
+            case DL_END_TEXT: dc->EndText(); break;
+            case DL_MOVE_TEXT_TO: dc->MoveTextTo(args[0], args[1], (data_HORIZONTALALIGNMENT)args[2]); break;
+            case DL_MOVE_TEXT_VERTICALLY_TO: dc->MoveTextVerticallyTo(args[0]); break;
+            case DL_START_GRAPHIC:
+                dc->StartGraphic(command.m_object, m_strings.at(args[0]), m_strings.at(args[1]), (GraphicID)args[2],
+                    args[3]);
+                break;
+            case DL_END_GRAPHIC: dc->EndGraphic(command.m_object, command.m_view); break;
+            case DL_START_CUSTOM_GRAPHIC:
+                dc->StartCustomGraphic(m_strings.at(args[0]), m_strings.at(args[1]), m_strings.at(args[2]));
+                break;
+            case DL_END_CUSTOM_GRAPHIC: dc->EndCustomGraphic(); break;
+            case DL_RESUME_GRAPHIC: dc->ResumeGraphic(command.m_object, m_strings.at(args[0])); break;
+            case DL_END_RESUMED_GRAPHIC: dc->EndResumedGraphic(command.m_object, command.m_view); break;
+            case DL_START_TEXT_GRAPHIC:
+                dc->StartTextGraphic(command.m_object, m_strings.at(args[0]), m_strings.at(args[1]));
+                break;
+            case DL_END_TEXT_GRAPHIC: dc->EndTextGraphic(command.m_object, command.m_view); break;
+            case DL_ROTATE_GRAPHIC: dc->RotateGraphic(Point(args[0], args[1]), command.m_values[0]); break;
+            case DL_START_PAGE: dc->StartPage(); break;
+            case DL_END_PAGE: dc->EndPage(); break;
+            case DL_ADD_DESCRIPTION: dc->AddDescription(m_strings.at(args[0])); break;
+            default: assert(false);
+        }
+    }
+
+    this->ResetState(dc);
+
+    if (!dcHasResources) dc->ResetResources();
+}
+
+} // namespace vrv
@@ -82,6 +82,8 @@ Doc::Doc() : Object(DOC, "doc-")
     m_selectionPreceding = NULL;
     m_selectionFollowing = NULL;
 
+    m_structureGeneration = 0;
+
     this->Reset();
 }
 
@@ -117,6 +119,7 @@ void Doc::Reset()
     m_drawingPageMarginTop = 0;
 
     m_drawingPage = NULL;
+    ++m_structureGeneration;
     m_currentScore = NULL;
     m_currentScoreDefDone = false;
     m_dataPreparationDone = false;
@@ -130,6 +133,10 @@ void Doc::Reset()
     m_drawingSmuflFontSize = 0;
     m_drawingLyricFontSize = 0;
 
+    m_glyphMetricTables.clear();
+    m_glyphMetricsFontSize = 0;
+    m_glyphMetricsGraceFactor = 0.0;
+
     m_header.reset();
     m_front.reset();
     m_back.reset();
@@ -147,6 +154,7 @@ void Doc::ClearSelectionPages()
     }
     m_selectionStart = "";
     m_selectionEnd = "";
+    m_selectionMeasures.clear();
 }
 
 void Doc::SetType(DocType type)
@@ -280,7 +288,12 @@ void Doc::CalculateTimemap()
             return;
         }
         this->ScoreDefSetCurrentDoc();
-        page->LayOutHorizontally();
+        if (m_options->m_performanceOnly.GetValue()) {
+            page->AlignTiming();
+        }
+        else {
+            page->LayOutHorizontally();
+        }
     }
 
     double tempo = MIDI_TEMPO;
@@ -478,20 +491,31 @@ bool Doc::ExportTimemap(std::string &output, bool includeRests, bool includeMeas
 
 bool Doc::ExportFeatures(std::string &output, const std::string &options)
 {
+    FeatureExtractor extractor(options);
+    if (!this->ExtractFeatures(&extractor)) {
+        output = "";
+        return false;
+    }
+    extractor.ToJson(output);
+
+    return true;
+}
+
+bool Doc::ExtractFeatures(FeatureExtractor *extractor)
+{
+    assert(extractor);
+
     if (!Doc::HasTimemap()) {
         // generate MIDI timemap before progressing
         CalculateTimemap();
     }
     if (!Doc::HasTimemap()) {
-        LogWarning("Calculation of MIDI timemap failed, not exporting MidiFile.");
-        output = "";
+        LogWarning("Calculation of MIDI timemap failed, not extracting features.");
         return false;
     }
-    FeatureExtractor extractor(options);
     Functor generateFeatures(&Object::GenerateFeatures);
-    GenerateFeaturesParams generateFeaturesParams(this, &extractor);
+    GenerateFeaturesParams generateFeaturesParams(this, extractor);
     this->Process(&generateFeatures, &generateFeaturesParams);
-    extractor.ToJson(output);
 
     return true;
 }
@@ -923,7 +947,12 @@ void Doc::CastOffSmartDoc()
     Doc::CastOffDocBase(false, false, true);
 }
 
-void Doc::CastOffDocBase(bool useSb, bool usePb, bool smart)
+void Doc::CastOffOptimalDoc()
+{
+    Doc::CastOffDocBase(false, false, false, true);
+}
+
+void Doc::CastOffDocBase(bool useSb, bool usePb, bool smart, bool optimal)
 {
     Pages *pages = this->GetPages();
     assert(pages);
@@ -964,6 +993,7 @@ void Doc::CastOffDocBase(bool useSb, bool usePb, bool smart)
     else {
         CastOffSystemsParams castOffSystemsParams(castOffSinglePage, this, smart);
         castOffSystemsParams.m_systemWidth = m_drawingPageContentWidth;
+        castOffSystemsParams.m_optimal = optimal;
 
         Functor castOffSystems(&Object::CastOffSystems);
         Functor castOffSystemsEnd(&Object::CastOffSystemsEnd);
@@ -1136,8 +1166,13 @@ void Doc::InitSelectionDoc(DocSelection &selection, bool resetCache)
 
     Page *unCastOffPage = this->SetDrawingPage(0);
 
-    // Make sure we have global slurs curve dir
-    unCastOffPage->ResetAligners();
+    // Make sure we have the slurs curve dir for the selection and its boundary
+    // The content outside is not rendered and is not aligned
+    this->InitSelectionMeasures(unCastOffPage);
+    Filters filters;
+    MeasureInSetComparison matchSelectionMeasures(&m_selectionMeasures);
+    filters.Add(&matchSelectionMeasures);
+    unCastOffPage->ResetAligners(&filters);
 
     // We can now detach and delete the old content page
     pages->DetachChild(0);
@@ -1177,6 +1212,7 @@ void Doc::ResetSelectionDoc(bool resetCache)
 
     m_selectionStart = "";
     m_selectionEnd = "";
+    m_selectionMeasures.clear();
 
     if (this->IsCastOff()) this->UnCastOffDoc();
 
@@ -1210,6 +1246,7 @@ void Doc::DeactiveateSelection()
 
     m_selectionPreceding = NULL;
     m_selectionFollowing = NULL;
+    ++m_structureGeneration;
 }
 
 void Doc::ReactivateSelection(bool resetAligners)
@@ -1231,25 +1268,89 @@ void Doc::ReactivateSelection(bool resetAligners)
     selectionScore->SetParent(selectionPage);
     selectionPage->InsertChild(selectionScore, 0);
 
+    // Only the boundary measures are processed
+    Filters filters;
+    MeasureInSetComparison matchSelectionMeasures(&m_selectionMeasures);
+    filters.Add(&matchSelectionMeasures);
+
     m_selectionPreceding = vrv_cast<Page *>(pages->GetChild(0));
     // Reset the aligners because data will be accessed when rendering control events outside the selection
     if (resetAligners && m_selectionPreceding->FindDescendantByType(MEASURE)) {
         this->SetDrawingPage(0);
-        m_selectionPreceding->ResetAligners();
+        m_selectionPreceding->ResetAligners(&filters);
     }
 
     m_selectionFollowing = vrv_cast<Page *>(pages->GetChild(lastPage));
     // Same for the following content
     if (resetAligners && m_selectionFollowing->FindDescendantByType(MEASURE)) {
         this->SetDrawingPage(2);
-        m_selectionFollowing->ResetAligners();
+        m_selectionFollowing->ResetAligners(&filters);
     }
 
     // Detach the preceding and following page
     pages->DetachChild(lastPage);
     pages->DetachChild(0);
     // Make sure we do not point to page moved out of the selection
-    this->m_drawingPage = NULL;
+    this->ResetDataPage();
+}
+
+void Doc::InitSelectionMeasures(Page *unCastOffPage)
+{
+    assert(unCastOffPage);
+
+    m_selectionMeasures.clear();
+
+    // Measures are not searched for within measures, which keeps this proportional to the number of measures
+    ListOfObjects measureList = unCastOffPage->FindAllDescendantsByType(MEASURE, false);
+    std::vector<Object *> measures(measureList.begin(), measureList.end());
+
+    // Index the measures by ID and by position
+    std::unordered_map<std::string, int> measureIdxByID;
+    std::unordered_map<const Object *, int> measureIdx;
+    for (int i = 0; i < (int)measures.size(); ++i) {
+        measureIdxByID[measures.at(i)->GetID()] = i;
+        measureIdx[measures.at(i)] = i;
+    }
+
+    auto startIt = measureIdxByID.find(m_selectionStart);
+    if (startIt == measureIdxByID.end()) return;
+    const int start = startIt->second;
+    auto endIt = measureIdxByID.find(m_selectionEnd);
+    const int end = (endIt != measureIdxByID.end()) ? endIt->second : (int)measures.size() - 1;
+
+    int boundaryStart = start;
+    int boundaryEnd = std::max(start, end);
+
+    // Look at the time spanning elements of each measure - editorial elements are not counted in the deepness
+    InterfaceComparison matchTimeSpanning(INTERFACE_TIME_SPANNING);
+    for (int i = 0; i < (int)measures.size(); ++i) {
+        ListOfObjects timeSpanningElements;
+        measures.at(i)->FindAllDescendantsByComparison(&timeSpanningElements, &matchTimeSpanning, 1);
+        for (Object *object : timeSpanningElements) {
+            TimeSpanningInterface *interface = object->GetTimeSpanningInterface();
+            assert(interface);
+            int elementStart = i;
+            int elementEnd = i;
+            if (interface->GetStartMeasure() && measureIdx.count(interface->GetStartMeasure())) {
+                elementStart = measureIdx.at(interface->GetStartMeasure());
+            }
+            if (interface->GetEndMeasure() && measureIdx.count(interface->GetEndMeasure())) {
+                elementEnd = measureIdx.at(interface->GetEndMeasure());
+            }
+            // The element crosses the selection start
+            if ((elementStart < start) && (elementEnd >= start)) {
+                boundaryStart = std::min(boundaryStart, elementStart);
+            }
+            // The element crosses the selection end
+            if ((elementStart <= end) && (elementEnd > end)) {
+                boundaryEnd = std::max(boundaryEnd, elementEnd);
+            }
+        }
+    }
+
+    for (int i = boundaryStart; i <= boundaryEnd; ++i) {
+        m_selectionMeasures.insert(measures.at(i));
+    }
 }
 
 void Doc::ConvertToPageBasedDoc()
@@ -1513,6 +1614,9 @@ int Doc::GetPageCount() const
 
 int Doc::GetGlyphHeight(char32_t code, int staffSize, bool graceSize) const
 {
+    const GlyphMetrics *metrics = this->GetGlyphMetrics(code, staffSize, graceSize);
+    if (metrics) return metrics->m_height;
+
     int x, y, w, h;
     const Resources &resources = this->GetResources();
     const Glyph *glyph = resources.GetGlyph(code);
@@ -1526,6 +1630,9 @@ int Doc::GetGlyphHeight(char32_t code, int staffSize, bool graceSize) const
 
 int Doc::GetGlyphWidth(char32_t code, int staffSize, bool graceSize) const
 {
+    const GlyphMetrics *metrics = this->GetGlyphMetrics(code, staffSize, graceSize);
+    if (metrics) return metrics->m_width;
+
     int x, y, w, h;
     const Resources &resources = this->GetResources();
     const Glyph *glyph = resources.GetGlyph(code);
@@ -1539,6 +1646,9 @@ int Doc::GetGlyphWidth(char32_t code, int staffSize, bool graceSize) const
 
 int Doc::GetGlyphAdvX(char32_t code, int staffSize, bool graceSize) const
 {
+    const GlyphMetrics *metrics = this->GetGlyphMetrics(code, staffSize, graceSize);
+    if (metrics) return metrics->m_advX;
+
     const Resources &resources = this->GetResources();
     const Glyph *glyph = resources.GetGlyph(code);
     assert(glyph);
@@ -1567,8 +1677,34 @@ Point Doc::ConvertFontPoint(const Glyph *glyph, const Point &fontPoint, int staf
     return point;
 }
 
+bool Doc::GetGlyphAnchor(char32_t code, SMuFLGlyphAnchor anchor, int staffSize, bool graceSize, Point &point) const
+{
+    // Only the stem anchors are stored in the tables
+    const GlyphMetrics *metrics = this->GetGlyphMetrics(code, staffSize, graceSize);
+    if (metrics && (anchor == SMUFL_stemUpSE)) {
+        if (metrics->m_hasStemUpSE) point = metrics->m_stemUpSE;
+        return metrics->m_hasStemUpSE;
+    }
+    if (metrics && (anchor == SMUFL_stemDownNW)) {
+        if (metrics->m_hasStemDownNW) point = metrics->m_stemDownNW;
+        return metrics->m_hasStemDownNW;
+    }
+
+    const Resources &resources = this->GetResources();
+    const Glyph *glyph = resources.GetGlyph(code);
+    assert(glyph);
+    if (!glyph->HasAnchor(anchor)) return false;
+    const Point *fontPoint = glyph->GetAnchor(anchor);
+    assert(fontPoint);
+    point = this->ConvertFontPoint(glyph, *fontPoint, staffSize, graceSize);
+    return true;
+}
+
 int Doc::GetGlyphLeft(char32_t code, int staffSize, bool graceSize) const
 {
+    const GlyphMetrics *metrics = this->GetGlyphMetrics(code, staffSize, graceSize);
+    if (metrics) return metrics->m_x;
+
     int x, y, w, h;
     const Resources &resources = this->GetResources();
     const Glyph *glyph = resources.GetGlyph(code);
@@ -1587,6 +1723,9 @@ int Doc::GetGlyphRight(char32_t code, int staffSize, bool graceSize) const
 
 int Doc::GetGlyphBottom(char32_t code, int staffSize, bool graceSize) const
 {
+    const GlyphMetrics *metrics = this->GetGlyphMetrics(code, staffSize, graceSize);
+    if (metrics) return metrics->m_y;
+
     int x, y, w, h;
     const Resources &resources = this->GetResources();
     const Glyph *glyph = resources.GetGlyph(code);
@@ -1603,6 +1742,85 @@ int Doc::GetGlyphTop(char32_t code, int staffSize, bool graceSize) const
     return this->GetGlyphBottom(code, staffSize, graceSize) + this->GetGlyphHeight(code, staffSize, graceSize);
 }
 
+const GlyphMetrics *Doc::GetGlyphMetrics(char32_t code, int staffSize, bool graceSize) const
+{
+    if ((code < SMUFL_CODE_FIRST) || (code > SMUFL_CODE_LAST)) return NULL;
+    // The tables are reset in SetDrawingPage, but the font size or the options can change in between
+    if ((m_glyphMetricsFontSize != m_drawingSmuflFontSize)
+        || (m_glyphMetricsGraceFactor != m_options->m_graceFactor.GetValue())) {
+        return NULL;
+    }
+
+    const GlyphMetrics *metrics = NULL;
+    for (const GlyphMetricTable &table : m_glyphMetricTables) {
+        if ((table.m_staffSize == staffSize) && (table.m_graceSize == graceSize)) {
+            metrics = &table.m_metrics[code - SMUFL_CODE_FIRST];
+            break;
+        }
+    }
+    if (!metrics) {
+        metrics = &this->BuildGlyphMetricTable(staffSize, graceSize).m_metrics[code - SMUFL_CODE_FIRST];
+    }
+    return (metrics->m_isSet) ? metrics : NULL;
+}
+
+const GlyphMetricTable &Doc::BuildGlyphMetricTable(int staffSize, bool graceSize) const
+{
+    const Resources &resources = this->GetResources();
+    const double graceFactor = m_options->m_graceFactor.GetValue();
+
+    // Scale the values as in the Doc::GetGlyph* methods
+    auto scale = [this, staffSize, graceSize, graceFactor](int value, int unitsPerEm) {
+        value = value * m_drawingSmuflFontSize / unitsPerEm;
+        if (graceSize) value = value * graceFactor;
+        return value * staffSize / 100;
+    };
+
+    GlyphMetricTable table;
+    table.m_staffSize = staffSize;
+    table.m_graceSize = graceSize;
+    table.m_metrics.resize(SMUFL_CODE_LAST - SMUFL_CODE_FIRST + 1);
+    for (char32_t code = SMUFL_CODE_FIRST; code <= SMUFL_CODE_LAST; ++code) {
+        GlyphMetrics &metrics = table.m_metrics[code - SMUFL_CODE_FIRST];
+        metrics = {};
+        const Glyph *glyph = resources.GetGlyph(code);
+        if (!glyph) continue;
+        const int unitsPerEm = glyph->GetUnitsPerEm();
+        int x, y, w, h;
+        glyph->GetBoundingBox(x, y, w, h);
+        metrics.m_x = scale(x, unitsPerEm);
+        metrics.m_y = scale(y, unitsPerEm);
+        metrics.m_width = scale(w, unitsPerEm);
+        metrics.m_height = scale(h, unitsPerEm);
+        metrics.m_advX = scale(glyph->GetHorizAdvX(), unitsPerEm);
+        metrics.m_hasStemUpSE = glyph->HasAnchor(SMUFL_stemUpSE);
+        if (metrics.m_hasStemUpSE) {
+            metrics.m_stemUpSE = this->ConvertFontPoint(glyph, *glyph->GetAnchor(SMUFL_stemUpSE), staffSize, graceSize);
+        }
+        metrics.m_hasStemDownNW = glyph->HasAnchor(SMUFL_stemDownNW);
+        if (metrics.m_hasStemDownNW) {
+            metrics.m_stemDownNW
+                = this->ConvertFontPoint(glyph, *glyph->GetAnchor(SMUFL_stemDownNW), staffSize, graceSize);
+        }
+        metrics.m_isSet = true;
+    }
+    m_glyphMetricTables.push_back(std::move(table));
+    return m_glyphMetricTables.back();
+}
+
+void Doc::ResetGlyphMetrics()
+{
+    const double graceFactor = m_options->m_graceFactor.GetValue();
+    if ((m_glyphMetricsFontSize == m_drawingSmuflFontSize) && (m_glyphMetricsGraceFactor == graceFactor)) return;
+
+    m_glyphMetricTables.clear();
+    m_glyphMetricsFontSize = m_drawingSmuflFontSize;
+    m_glyphMetricsGraceFactor = graceFactor;
+    // The tables for the default staff size
+    this->BuildGlyphMetricTable(100, false);
+    this->BuildGlyphMetricTable(100, true);
+}
+
 int Doc::GetTextGlyphHeight(char32_t code, const FontInfo *font, bool graceSize) const
 {
     assert(font);
@@ -1960,6 +2178,7 @@ Page *Doc::SetDrawingPage(int pageIdx)
     }
     // nothing to do
     if (m_drawingPage && m_drawingPage->GetIdx() == pageIdx) {
+        this->ResetGlyphMetrics();
         return m_drawingPage;
     }
     Pages *pages = this->GetPages();
@@ -2031,6 +2250,8 @@ Page *Doc::SetDrawingPage(int pageIdx)
     m_drawingLyricFontSize = m_options->m_unit.GetValue() * m_options->m_lyricSize.GetValue();
     m_fingeringFontSize = m_drawingLyricFontSize * m_options->m_fingeringScale.GetValue();
 
+    this->ResetGlyphMetrics();
+
     glyph_size = this->GetGlyphWidth(SMUFL_E0A2_noteheadWhole, 100, 0);
 
     m_drawingBrevisWidth = (int)((glyph_size * 0.8) / 2);
@@ -32,7 +32,7 @@ static const ClassRegistrar<Ending> s_factory("ending", ENDING);
 Ending::Ending() : SystemElement(ENDING, "ending-"), SystemMilestoneInterface(), AttLineRend(), AttNNumberLike()
 {
     this->RegisterAttClass(ATT_LINEREND);
-    this->RegisterAttClass(ATT_NINTEGER);
+    this->RegisterAttClass(ATT_NNUMBERLIKE);
 
     this->Reset();
 }
@@ -0,0 +1,439 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        featureindex.cpp
+// Author:      Laurent Pugin
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "featureindex.h"
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+
+//----------------------------------------------------------------------------
+
+#include "featureextractor.h"
+#include "vrv.h"
+
+//----------------------------------------------------------------------------
+
+#include "jsonxx.h"
+
+#define FEATURE_INDEX_MAGIC "VRVFIDX1"
+#define FEATURE_INDEX_VERSION 1
+#define FEATURE_INDEX_NGRAM_SIZE 4
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// Sections of the index file
+//----------------------------------------------------------------------------
+
+/**
+ * The file is made of the header followed by the keys, the postings, the documents, the ids,
+ * the sequences and the strings. All the sections are stored in native byte order.
+ */
+struct FeatureIndexHeader {
+    char m_magic[8];
+    uint32_t m_version;
+    uint32_t m_ngramSize;
+    uint32_t m_documentCount;
+    uint32_t m_keyCount;
+    uint32_t m_postingCount;
+    uint32_t m_idCount;
+    uint64_t m_sequencesSize;
+    uint64_t m_stringsSize;
+};
+
+/** An n-gram with the range of its postings */
+struct FeatureIndexKey {
+    uint64_t m_key;
+    uint32_t m_firstPosting;
+    uint32_t m_postingCount;
+};
+
+/** A position (in intervals) in a document */
+struct FeatureIndexPosting {
+    uint32_t m_document;
+    uint32_t m_position;
+};
+
+/** A document with its name, its note ids and its sequences (one byte per interval and per type) */
+struct FeatureIndexDocument {
+    uint32_t m_name;
+    uint32_t m_firstId;
+    uint32_t m_idCount;
+    uint32_t m_sequences;
+};
+
+//----------------------------------------------------------------------------
+// FeatureIndex
+//----------------------------------------------------------------------------
+
+FeatureIndex::FeatureIndex()
+{
+    m_ngramSize = FEATURE_INDEX_NGRAM_SIZE;
+    m_data = NULL;
+    m_size = 0;
+
+    this->Reset();
+}
+
+void FeatureIndex::Reset()
+{
+    m_pendingDocuments.clear();
+    m_isModified = false;
+    m_buffer.clear();
+    m_file.Close();
+    m_data = NULL;
+    m_size = 0;
+}
+
+int FeatureIndex::GetDocumentCount() const
+{
+    if (m_file.IsOpen()) {
+        return (int)reinterpret_cast<const FeatureIndexHeader *>(m_data)->m_documentCount;
+    }
+    return (int)m_pendingDocuments.size();
+}
+
+uint8_t FeatureIndex::EncodeInterval(int interval)
+{
+    return (uint8_t)(std::clamp(interval, -127, 127) + 128);
+}
+
+uint8_t FeatureIndex::EncodeContour(char contour)
+{
+    switch (contour) {
+        case 'D': return 1;
+        case 'd': return 2;
+        case 's': return 3;
+        case 'u': return 4;
+        case 'U': return 5;
+        default: return 0;
+    }
+}
+
+uint64_t FeatureIndex::MakeKey(FeatureIndexType type, const uint8_t *sequence, int length, int position) const
+{
+    // The type is stored in the top byte followed by the values, the first one being the most significant
+    uint64_t key = (uint64_t)type << 56;
+    for (int i = 0; i < m_ngramSize; ++i) {
+        if (position + i >= length) break;
+        key |= (uint64_t)sequence[position + i] << (48 - 8 * i);
+    }
+    return key;
+}
+
+bool FeatureIndex::AddDocument(const std::string &name, const FeatureExtractor &extractor)
+{
+    if (m_file.IsOpen()) {
+        LogError("A feature index loaded from a file cannot be modified");
+        return false;
+    }
+
+    PendingDocument document;
+    document.m_name = name;
+
+    const jsonxx::Array &pitchesIds = extractor.m_pitchesIds;
+    for (int i = 0; i < (int)pitchesIds.size(); ++i) {
+        const jsonxx::Array &ids = pitchesIds.get<jsonxx::Array>(i);
+        document.m_ids.push_back(ids.size() > 0 ? ids.get<jsonxx::String>(0) : "");
+    }
+
+    // We expect one interval less than pitches
+    const int intervalCount = std::max(0, (int)document.m_ids.size() - 1);
+    const jsonxx::Array &intervalsChromatic = extractor.m_intervalsChromatic;
+    const jsonxx::Array &intervalsDiatonic = extractor.m_intervalsDiatonic;
+    const jsonxx::Array &intervalRefinedContour = extractor.m_intervalRefinedContour;
+    if (((int)intervalsChromatic.size() != intervalCount) || ((int)intervalsDiatonic.size() != intervalCount)
+        || ((int)intervalRefinedContour.size() != intervalCount)) {
+        LogError("Inconsistent features for document '%s'", name.c_str());
+        return false;
+    }
+    for (int i = 0; i < intervalCount; ++i) {
+        document.m_sequences[FEATURE_INDEX_INTERVALS_CHROMATIC].push_back(
+            EncodeInterval(atoi(intervalsChromatic.get<jsonxx::String>(i).c_str())));
+        document.m_sequences[FEATURE_INDEX_INTERVALS_DIATONIC].push_back(
+            EncodeInterval(atoi(intervalsDiatonic.get<jsonxx::String>(i).c_str())));
+        const std::string &contour = intervalRefinedContour.get<jsonxx::String>(i);
+        document.m_sequences[FEATURE_INDEX_CONTOUR].push_back(contour.empty() ? 0 : EncodeContour(contour.at(0)));
+    }
+
+    m_pendingDocuments.push_back(std::move(document));
+    m_isModified = true;
+    return true;
+}
+
+void FeatureIndex::Finalize()
+{
+    if (m_file.IsOpen() || (m_data && !m_isModified)) return;
+
+    std::map<uint64_t, std::vector<FeatureIndexPosting>> postings;
+    std::vector<FeatureIndexDocument> documents;
+    std::vector<uint32_t> ids;
+    std::string sequences;
+    std::string strings;
+
+    for (int i = 0; i < (int)m_pendingDocuments.size(); ++i) {
+        const PendingDocument &pending = m_pendingDocuments.at(i);
+        FeatureIndexDocument document;
+        document.m_name = (uint32_t)strings.size();
+        strings.append(pending.m_name).push_back('\0');
+        document.m_firstId = (uint32_t)ids.size();
+        document.m_idCount = (uint32_t)pending.m_ids.size();
+        for (const std::string &id : pending.m_ids) {
+            ids.push_back((uint32_t)strings.size());
+            strings.append(id).push_back('\0');
+        }
+        document.m_sequences = (uint32_t)sequences.size();
+        for (int type = 0; type < FEATURE_INDEX_TYPE_COUNT; ++type) {
+            const std::vector<uint8_t> &sequence = pending.m_sequences[type];
+            sequences.append(sequence.begin(), sequence.end());
+            for (int position = 0; position < (int)sequence.size(); ++position) {
+                uint64_t key = this->MakeKey(
+                    (FeatureIndexType)type, sequence.data(), (int)sequence.size(), position);
+                postings[key].push_back({ (uint32_t)i, (uint32_t)position });
+            }
+        }
+        documents.push_back(document);
+    }
+
+    std::vector<FeatureIndexKey> keys;
+    keys.reserve(postings.size());
+    uint32_t postingCount = 0;
+    for (const auto &[key, list] : postings) {
+        keys.push_back({ key, postingCount, (uint32_t)list.size() });
+        postingCount += (uint32_t)list.size();
+    }
+
+    FeatureIndexHeader header;
+    memcpy(header.m_magic, FEATURE_INDEX_MAGIC, sizeof(header.m_magic));
+    header.m_version = FEATURE_INDEX_VERSION;
+    header.m_ngramSize = (uint32_t)m_ngramSize;
+    header.m_documentCount = (uint32_t)documents.size();
+    header.m_keyCount = (uint32_t)keys.size();
+    header.m_postingCount = postingCount;
+    header.m_idCount = (uint32_t)ids.size();
+    header.m_sequencesSize = sequences.size();
+    header.m_stringsSize = strings.size();
+
+    m_buffer.clear();
+    m_buffer.reserve(sizeof(FeatureIndexHeader) + keys.size() * sizeof(FeatureIndexKey)
+        + postingCount * sizeof(FeatureIndexPosting) + documents.size() * sizeof(FeatureIndexDocument)
+        + ids.size() * sizeof(uint32_t) + sequences.size() + strings.size());
+    m_buffer.append(reinterpret_cast<const char *>(&header), sizeof(FeatureIndexHeader));
+    m_buffer.append(reinterpret_cast<const char *>(keys.data()), keys.size() * sizeof(FeatureIndexKey));
+    for (const auto &[key, list] : postings) {
+        m_buffer.append(reinterpret_cast<const char *>(list.data()), list.size() * sizeof(FeatureIndexPosting));
+    }
+    m_buffer.append(
+        reinterpret_cast<const char *>(documents.data()), documents.size() * sizeof(FeatureIndexDocument));
+    m_buffer.append(reinterpret_cast<const char *>(ids.data()), ids.size() * sizeof(uint32_t));
+    m_buffer.append(sequences);
+    m_buffer.append(strings);
+
+    m_isModified = false;
+    [[maybe_unused]] const bool isValid = this->SetView(m_buffer.data(), m_buffer.size());
+    assert(isValid);
+}
+
+bool FeatureIndex::SetView(const char *data, size_t size)
+{
+    m_data = NULL;
+    m_size = 0;
+
+    if (!data || (size < sizeof(FeatureIndexHeader))) return false;
+    const FeatureIndexHeader *header = reinterpret_cast<const FeatureIndexHeader *>(data);
+    if (memcmp(header->m_magic, FEATURE_INDEX_MAGIC, sizeof(header->m_magic)) != 0) return false;
+    if (header->m_version != FEATURE_INDEX_VERSION) return false;
+    if ((header->m_ngramSize < 1) || (header->m_ngramSize > 7)) return false;
+
+    // Check the size of each section against the remaining size so the sum cannot overflow
+    const uint64_t sectionSizes[] = { (uint64_t)header->m_keyCount * sizeof(FeatureIndexKey),
+        (uint64_t)header->m_postingCount * sizeof(FeatureIndexPosting),
+        (uint64_t)header->m_documentCount * sizeof(FeatureIndexDocument),
+        (uint64_t)header->m_idCount * sizeof(uint32_t), header->m_sequencesSize, header->m_stringsSize };
+    uint64_t remaining = size - sizeof(FeatureIndexHeader);
+    for (uint64_t sectionSize : sectionSizes) {
+        if (sectionSize > remaining) return false;
+        remaining -= sectionSize;
+    }
+    if (remaining != 0) return false;
+
+    const FeatureIndexKey *keys = reinterpret_cast<const FeatureIndexKey *>(data + sizeof(FeatureIndexHeader));
+    const FeatureIndexPosting *postings = reinterpret_cast<const FeatureIndexPosting *>(keys + header->m_keyCount);
+    const FeatureIndexDocument *documents
+        = reinterpret_cast<const FeatureIndexDocument *>(postings + header->m_postingCount);
+    const uint32_t *ids = reinterpret_cast<const uint32_t *>(documents + header->m_documentCount);
+    const char *strings = reinterpret_cast<const char *>(ids + header->m_idCount) + header->m_sequencesSize;
+
+    // Every offset has to point within its section - the keys also have to be sorted for the lookup
+    for (uint32_t i = 0; i < header->m_keyCount; ++i) {
+        if ((i > 0) && (keys[i].m_key <= keys[i - 1].m_key)) return false;
+        if ((uint64_t)keys[i].m_firstPosting + keys[i].m_postingCount > header->m_postingCount) return false;
+    }
+    for (uint32_t i = 0; i < header->m_documentCount; ++i) {
+        const FeatureIndexDocument &document = documents[i];
+        if (document.m_name >= header->m_stringsSize) return false;
+        if ((uint64_t)document.m_firstId + document.m_idCount > header->m_idCount) return false;
+        const uint64_t intervalCount = (document.m_idCount > 0) ? document.m_idCount - 1 : 0;
+        if (document.m_sequences + FEATURE_INDEX_TYPE_COUNT * intervalCount > header->m_sequencesSize) return false;
+    }
+    for (uint32_t i = 0; i < header->m_postingCount; ++i) {
+        if (postings[i].m_document >= header->m_documentCount) return false;
+        const FeatureIndexDocument &document = documents[postings[i].m_document];
+        if ((document.m_idCount == 0) || (postings[i].m_position >= document.m_idCount - 1)) return false;
+    }
+    for (uint32_t i = 0; i < header->m_idCount; ++i) {
+        if (ids[i] >= header->m_stringsSize) return false;
+    }
+    // With all offsets within the section, a final null terminator ensures all the strings are terminated
+    if ((header->m_stringsSize > 0) && (strings[header->m_stringsSize - 1] != '\0')) return false;
+
+    m_ngramSize = (int)header->m_ngramSize;
+    m_data = data;
+    m_size = size;
+    return true;
+}
+
+bool FeatureIndex::Save(const std::string &filename)
+{
+    this->Finalize();
+
+    std::ofstream output(filename.c_str(), std::ios::out | std::ios::binary);
+    if (!output.is_open()) {
+        LogError("Unable to write the feature index to '%s'", filename.c_str());
+        return false;
+    }
+    output.write(m_data, m_size);
+    return output.good();
+}
+
+bool FeatureIndex::Load(const std::string &filename)
+{
+    this->Reset();
+
+    if (!m_file.Open(filename)) {
+        LogError("Unable to open the feature index '%s'", filename.c_str());
+        return false;
+    }
+    if (!this->SetView(m_file.GetData(), m_file.GetSize())) {
+        LogError("'%s' is not a valid feature index file", filename.c_str());
+        this->Reset();
+        return false;
+    }
+    return true;
+}
+
+bool FeatureIndex::Query(const std::string &query, std::string &output)
+{
+    output = "";
+
+    jsonxx::Object json;
+    if (!json.parse(query)) {
+        LogError("Cannot parse JSON std::string.");
+        return false;
+    }
+
+    FeatureIndexType type;
+    std::vector<uint8_t> pattern;
+    if (json.has<jsonxx::Array>("intervals") || json.has<jsonxx::Array>("intervalsDiatonic")) {
+        const bool isChromatic = json.has<jsonxx::Array>("intervals");
+        type = (isChromatic) ? FEATURE_INDEX_INTERVALS_CHROMATIC : FEATURE_INDEX_INTERVALS_DIATONIC;
+        const jsonxx::Array &intervals = json.get<jsonxx::Array>((isChromatic) ? "intervals" : "intervalsDiatonic");
+        for (int i = 0; i < (int)intervals.size(); ++i) {
+            if (!intervals.has<jsonxx::Number>(i)) {
+                LogError("Intervals in a feature index query have to be numbers");
+                return false;
+            }
+            pattern.push_back(EncodeInterval((int)intervals.get<jsonxx::Number>(i)));
+        }
+    }
+    else if (json.has<jsonxx::String>("contour")) {
+        type = FEATURE_INDEX_CONTOUR;
+        for (char symbol : json.get<jsonxx::String>("contour")) {
+            const uint8_t value = EncodeContour(symbol);
+            if (value == 0) {
+                LogError("Unsupported contour symbol '%c' in a feature index query", symbol);
+                return false;
+            }
+            pattern.push_back(value);
+        }
+    }
+    if (pattern.empty()) {
+        LogError("A feature index query requires non-empty 'intervals', 'intervalsDiatonic' or 'contour'");
+        return false;
+    }
+    const int limit = (json.has<jsonxx::Number>("limit")) ? (int)json.get<jsonxx::Number>("limit") : 0;
+
+    this->Finalize();
+    if (!m_data) return false;
+
+    const FeatureIndexHeader *header = reinterpret_cast<const FeatureIndexHeader *>(m_data);
+    const FeatureIndexKey *keys = reinterpret_cast<const FeatureIndexKey *>(m_data + sizeof(FeatureIndexHeader));
+    const FeatureIndexPosting *postings = reinterpret_cast<const FeatureIndexPosting *>(keys + header->m_keyCount);
+    const FeatureIndexDocument *documents
+        = reinterpret_cast<const FeatureIndexDocument *>(postings + header->m_postingCount);
+    const uint32_t *ids = reinterpret_cast<const uint32_t *>(documents + header->m_documentCount);
+    const uint8_t *sequences = reinterpret_cast<const uint8_t *>(ids + header->m_idCount);
+    const char *strings = reinterpret_cast<const char *>(sequences + header->m_sequencesSize);
+
+    // The keys of the n-grams starting with the pattern (or with its beginning) form a contiguous range
+    const int length = (int)pattern.size();
+    const int prefixLength = std::min(length, m_ngramSize);
+    const uint64_t first = this->MakeKey(type, pattern.data(), prefixLength, 0);
+    uint64_t last = first;
+    for (int i = prefixLength; i < m_ngramSize; ++i) last |= (uint64_t)0xFF << (48 - 8 * i);
+
+    const FeatureIndexKey *keysEnd = keys + header->m_keyCount;
+    const FeatureIndexKey *key = std::lower_bound(
+        keys, keysEnd, first, [](const FeatureIndexKey &entry, uint64_t value) { return entry.m_key < value; });
+
+    std::vector<FeatureIndexPosting> matches;
+    for (; (key != keysEnd) && (key->m_key <= last); ++key) {
+        for (uint32_t i = key->m_firstPosting; i < key->m_firstPosting + key->m_postingCount; ++i) {
+            const FeatureIndexPosting &posting = postings[i];
+            const FeatureIndexDocument &document = documents[posting.m_document];
+            const uint32_t intervalCount = (document.m_idCount > 0) ? document.m_idCount - 1 : 0;
+            if ((uint64_t)posting.m_position + length > intervalCount) continue;
+            // Patterns longer than the n-grams need to be verified against the sequence
+            if (length > m_ngramSize) {
+                const uint8_t *sequence = sequences + document.m_sequences + type * intervalCount;
+                if (memcmp(sequence + posting.m_position, pattern.data(), length) != 0) continue;
+            }
+            matches.push_back(posting);
+        }
+    }
+    std::sort(matches.begin(), matches.end(), [](const FeatureIndexPosting &a, const FeatureIndexPosting &b) {
+        return (a.m_document != b.m_document) ? (a.m_document < b.m_document) : (a.m_position < b.m_position);
+    });
+
+    jsonxx::Array results;
+    for (int i = 0; i < (int)matches.size(); ++i) {
+        if ((limit > 0) && (i >= limit)) break;
+        const FeatureIndexPosting &match = matches.at(i);
+        const FeatureIndexDocument &document = documents[match.m_document];
+        jsonxx::Array matchIds;
+        for (int j = 0; j <= length; ++j) {
+            matchIds << std::string(strings + ids[document.m_firstId + match.m_position + j]);
+        }
+        jsonxx::Object result;
+        result << "document" << std::string(strings + document.m_name);
+        result << "position" << (int)match.m_position;
+        result << "ids" << matchIds;
+        results << result;
+    }
+
+    jsonxx::Object o;
+    o << "count" << (int)matches.size();
+    o << "matches" << results;
+    output = o.json();
+    return true;
+}
+
+} // namespace vrv
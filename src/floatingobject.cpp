@@ -568,6 +568,7 @@ void FloatingCurvePositioner::ResetCurveParams()
     m_dir = curvature_CURVEDIR_NONE;
     m_crossStaff = NULL;
     m_cachedMinMaxY = VRV_UNSET;
+    m_cachedThickness = VRV_UNSET;
     m_cachedX12 = { VRV_UNSET, VRV_UNSET };
     m_requestedStaffSpace = 0;
     this->ClearSpannedElements();
@@ -689,7 +690,7 @@ std::pair<int, int> FloatingCurvePositioner::CalcDirectionalLeftRightAdjustment(
     }
 
     Point topBezier[4], bottomBezier[4];
-    BoundingBox::CalcThickBezier(points, this->GetThickness(), topBezier, bottomBezier);
+    this->GetThickBezier(topBezier, bottomBezier);
 
     // Now calculate the left and right adjustments
     int leftAdjustment = 0;
@@ -791,6 +792,21 @@ void FloatingCurvePositioner::GetPoints(Point points[4]) const
     points[3].y += currentY;
 }
 
+void FloatingCurvePositioner::GetThickBezier(Point topBezier[4], Point bottomBezier[4]) const
+{
+    Point points[4];
+    this->GetPoints(points);
+
+    if ((m_cachedThickness != m_thickness) || !std::equal(points, points + 4, m_cachedThickPoints)) {
+        BoundingBox::CalcThickBezier(points, m_thickness, m_cachedTopBezier, m_cachedBottomBezier);
+        std::copy(points, points + 4, m_cachedThickPoints);
+        m_cachedThickness = m_thickness;
+    }
+
+    std::copy(m_cachedTopBezier, m_cachedTopBezier + 4, topBezier);
+    std::copy(m_cachedBottomBezier, m_cachedBottomBezier + 4, bottomBezier);
+}
+
 std::pair<int, int> FloatingCurvePositioner::CalcRequestedStaffSpace(const StaffAlignment *alignment) const
 {
     assert(alignment);
@@ -90,9 +90,9 @@ ABCInput::~ABCInput() {}
 
 //////////////////////////////////////////////////////////////////////////
 
-bool ABCInput::Import(const std::string &abc)
+bool ABCInput::Import(std::string_view abc)
 {
-    std::istringstream in_stream(abc);
+    std::istringstream in_stream{ std::string(abc) };
     ParseABC(in_stream);
     return true;
 }
@@ -451,11 +451,13 @@ int DarmsInput::do_Note(int pos, const char *data, bool rest)
     return pos;
 }
 
-bool DarmsInput::Import(const std::string &data_str)
+bool DarmsInput::Import(std::string_view data_view)
 {
     int len;
     int res;
     int pos = 0;
+    // The parser relies on the data being null-terminated
+    const std::string data_str(data_view);
     const char *data = data_str.c_str();
     len = (int)data_str.length();
 
@@ -579,7 +579,7 @@ HumdrumInput::~HumdrumInput()
 // HumdrumInput::ImportString -- Read a Humdrum file set from a text string.
 //
 
-bool HumdrumInput::Import(const std::string &content)
+bool HumdrumInput::Import(std::string_view content)
 {
 
 #ifndef NO_HUMDRUM_SUPPORT
@@ -622,10 +622,10 @@ bool HumdrumInput::Import(const std::string &content)
 
         bool result;
         if (comma <= tab) {
-            result = m_infiles.readString(content);
+            result = m_infiles.readString(std::string(content));
         }
         else {
-            result = m_infiles.readStringCsv(content);
+            result = m_infiles.readStringCsv(std::string(content));
         }
 
         if (!result) {
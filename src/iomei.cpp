@@ -160,6 +160,8 @@ const std::vector<std::string> MEIInput::s_editorialElementNames = { "abbr", "ad
 
 MEIOutput::MEIOutput(Doc *doc) : Output(doc)
 {
+    m_stream = NULL;
+    m_outputFlags = pugi::format_default;
     m_indent = 5;
     m_scoreBasedMEI = false;
     m_basic = false;
@@ -173,6 +175,11 @@ MEIOutput::MEIOutput(Doc *doc) : Output(doc)
 MEIOutput::~MEIOutput() {}
 
 bool MEIOutput::Export()
+{
+    return this->Export(m_streamStringOutput);
+}
+
+bool MEIOutput::Export(std::ostream &stream)
 {
 
     if (m_removeIds) {
@@ -247,6 +254,18 @@ bool MEIOutput::Export()
         if (this->GetBasic()) meiVersion = meiVersion_MEIVERSION_5_0_0_devplusbasic;
         m_mei.append_attribute("meiversion") = (converter.MeiVersionMeiversionToStr(meiVersion)).c_str();
 
+        m_outputFlags = pugi::format_default;
+        if (m_doc->GetOptions()->m_outputSmuflXmlEntities.GetValue()) {
+            m_outputFlags |= pugi::format_no_escapes;
+        }
+        if (m_doc->GetOptions()->m_outputFormatRaw.GetValue()) {
+            m_outputFlags |= pugi::format_raw;
+        }
+        m_indentString = (m_indent == -1) ? "\t" : std::string(m_indent, ' ');
+        m_stream = &stream;
+        m_streamedNodes.clear();
+        m_streamedNodeDepths.clear();
+
         // If the document is mensural, we have to undo the mensural (segments) cast off
         m_doc->ConvertToCastOffMensuralDoc(false);
 
@@ -256,19 +275,19 @@ bool MEIOutput::Export()
 
         // Redo the mensural segment cast of if necessary
         m_doc->ConvertToCastOffMensuralDoc(true);
-        unsigned int output_flags = pugi::format_default;
-        if (m_doc->GetOptions()->m_outputSmuflXmlEntities.GetValue()) {
-            output_flags |= pugi::format_no_escapes;
-        }
-        if (m_doc->GetOptions()->m_outputFormatRaw.GetValue()) {
-            output_flags |= pugi::format_raw;
-        }
 
-        std::string indent = (m_indent == -1) ? "\t" : std::string(m_indent, ' ');
-        meiDoc.save(m_streamStringOutput, indent.c_str(), output_flags);
+        // Write what remains of the xml tree
+        while (!m_streamedNodes.empty()) {
+            this->StreamCloseNode();
+        }
+        this->StreamChildren(meiDoc, pugi::xml_node());
+        m_stream = NULL;
     }
     catch (char *str) {
         LogError("%s", str);
+        m_stream = NULL;
+        m_streamedNodes.clear();
+        m_streamedNodeDepths.clear();
         return false;
     }
 
@@ -290,7 +309,8 @@ bool MEIOutput::WriteObject(Object *object)
 {
     if (this->IsScoreBasedMEI() && this->HasFilter()) {
         if (!this->ProcessScoreBasedFilter(object)) {
-            return true;
+            // Once the end of the filter is reached, the rest of the tree does not need to be visited
+            return (m_filterMatchLocation != MatchLocation::After);
         }
     }
     return this->WriteObjectInternal(object, false);
@@ -305,7 +325,7 @@ bool MEIOutput::WriteObjectInternal(Object *object, bool useCustomScoreDef)
     // Main containers
     if (object->Is(DOC)) {
         this->WriteDoc(vrv_cast<Doc *>(object));
-        m_nodeStack.push_back(m_currentNode);
+        this->PushNode(m_currentNode);
         return true;
     }
 
@@ -897,7 +917,7 @@ bool MEIOutput::WriteObjectInternal(Object *object, bool useCustomScoreDef)
     }
 
     // Object representing an attribute have no node to push
-    if (this->IsTreeObject(object)) m_nodeStack.push_back(m_currentNode);
+    if (this->IsTreeObject(object)) this->PushNode(m_currentNode);
 
     if (object->Is(SCORE)) {
         if (useCustomScoreDef) {
@@ -973,13 +993,131 @@ bool MEIOutput::WriteObjectInternalEnd(Object *object)
 
     if (object->Is(DOC)) return true;
 
-    assert(!m_nodeStack.empty());
-    m_nodeStack.pop_back();
+    pugi::xml_node node = this->PopNode();
     m_currentNode = m_nodeStack.back();
 
+    // The element is complete and can be written to the stream
+    this->StreamNode(node);
+
     return true;
 }
 
+void MEIOutput::PushNode(pugi::xml_node node)
+{
+    m_nodeStack.push_back(node);
+    m_nodeStackSet.insert(node.internal_object());
+}
+
+pugi::xml_node MEIOutput::PopNode()
+{
+    assert(!m_nodeStack.empty());
+    pugi::xml_node node = m_nodeStack.back();
+    m_nodeStack.pop_back();
+    m_nodeStackSet.erase(m_nodeStackSet.find(node.internal_object()));
+    return node;
+}
+
+bool MEIOutput::IsStreamedNode(pugi::xml_node node) const
+{
+    // Containers with element children only, which are the only ones with a formatting independent from the content
+    static const std::unordered_set<std::string> streamedNames
+        = { "mei", "music", "body", "mdiv", "score", "section", "ending", "pages", "page", "system" };
+
+    for (; node && (node.type() != pugi::node_document); node = node.parent()) {
+        if (node.type() != pugi::node_element) return false;
+        if (!streamedNames.count(node.name())) return false;
+    }
+    return !node.empty();
+}
+
+void MEIOutput::StreamNode(pugi::xml_node node)
+{
+    if (!m_stream) return;
+
+    // The same node can be pushed more than once
+    if (m_nodeStackSet.count(node.internal_object())) return;
+
+    auto iter = m_streamedNodeDepths.find(node.internal_object());
+    if (iter != m_streamedNodeDepths.end()) {
+        // Close the node and the ones that are still open within it
+        const int count = (int)m_streamedNodes.size() - iter->second + 1;
+        for (int i = 0; i < count; ++i) {
+            this->StreamCloseNode();
+        }
+        return;
+    }
+
+    pugi::xml_node parent = node.parent();
+    if (!this->IsStreamedNode(parent)) return;
+
+    this->StreamOpenNode(parent);
+    this->StreamChildren(parent, node.next_sibling());
+}
+
+void MEIOutput::StreamOpenNode(pugi::xml_node node)
+{
+    if (node.type() == pugi::node_document) return;
+
+    if (m_streamedNodeDepths.count(node.internal_object())) return;
+
+    // Open the ancestors and write the preceding siblings first
+    pugi::xml_node parent = node.parent();
+    this->StreamOpenNode(parent);
+    this->StreamChildren(parent, node);
+
+    // Print a childless copy of the node with a placeholder child to get the tags formatted as by pugi
+    pugi::xml_document tags;
+    pugi::xml_node copy = tags.append_child(node.name());
+    for (pugi::xml_attribute attribute : node.attributes()) {
+        copy.append_attribute(attribute.name()) = attribute.value();
+    }
+    copy.append_child("_");
+    std::ostringstream stream;
+    copy.print(stream, m_indentString.c_str(), m_outputFlags, pugi::encoding_auto, (int)m_streamedNodes.size());
+    const std::string text = stream.str();
+
+    size_t start = text.find("<_");
+    size_t end = text.find("/>", start) + 2;
+    if (!(m_outputFlags & pugi::format_raw)) {
+        // Remove the indentation of the placeholder and its newline
+        start = text.rfind('\n', start) + 1;
+        if ((end < text.size()) && (text.at(end) == '\n')) ++end;
+    }
+
+    *m_stream << text.substr(0, start);
+    m_streamedNodes.push_back({ node, text.substr(end) });
+    m_streamedNodeDepths[node.internal_object()] = (int)m_streamedNodes.size();
+}
+
+void MEIOutput::StreamCloseNode()
+{
+    assert(!m_streamedNodes.empty());
+
+    pugi::xml_node node = m_streamedNodes.back().first;
+    this->StreamChildren(node, pugi::xml_node());
+    *m_stream << m_streamedNodes.back().second;
+    m_streamedNodeDepths.erase(node.internal_object());
+    m_streamedNodes.pop_back();
+    node.parent().remove_child(node);
+}
+
+void MEIOutput::StreamChildren(pugi::xml_node node, pugi::xml_node end)
+{
+    int depth = 0;
+    if (node.type() != pugi::node_document) {
+        assert(m_streamedNodeDepths.count(node.internal_object()));
+        depth = m_streamedNodeDepths.at(node.internal_object());
+    }
+
+    pugi::xml_node child = node.first_child();
+    while (child && (child != end)) {
+        pugi::xml_node next = child.next_sibling();
+        child.print(*m_stream, m_indentString.c_str(), m_outputFlags, pugi::encoding_auto, depth);
+        node.remove_child(child);
+        child = next;
+    }
+}
+
 bool MEIOutput::HasFilter() const
 {
     return m_hasFilter;
@@ -1454,7 +1592,7 @@ bool MEIOutput::WriteDoc(Doc *doc)
     if ((facs != NULL) && (facs->GetChildCount() > 0)) {
         pugi::xml_node facsimile = music.append_child("facsimile");
         this->WriteFacsimile(facsimile, facs);
-        m_nodeStack.push_back(facsimile);
+        this->PushNode(facsimile);
     }
 
     if (m_doc->m_front.first_child()) {
@@ -1462,7 +1600,7 @@ bool MEIOutput::WriteDoc(Doc *doc)
     }
 
     m_currentNode = music.append_child("body");
-    m_nodeStack.push_back(m_currentNode);
+    this->PushNode(m_currentNode);
 
     if (m_doc->m_back.first_child()) {
         music.append_copy(m_doc->m_back.first_child());
@@ -3284,13 +3422,32 @@ MEIInput::MEIInput(Doc *doc) : Input(doc)
 
 MEIInput::~MEIInput() {}
 
-bool MEIInput::Import(const std::string &mei)
+bool MEIInput::Import(std::string_view mei)
+{
+    try {
+        m_doc->Reset();
+        m_doc->SetType(Raw);
+        pugi::xml_document doc;
+        doc.load_buffer(mei.data(), mei.size(), (pugi::parse_comments | pugi::parse_default) & ~pugi::parse_eol,
+            pugi::encoding_utf8);
+        pugi::xml_node root = doc.first_child();
+        return this->ReadDoc(root);
+    }
+    catch (char *str) {
+        LogError("%s", str);
+        return false;
+    }
+}
+
+bool MEIInput::ImportInPlace(char *mei, size_t length)
 {
     try {
         m_doc->Reset();
         m_doc->SetType(Raw);
+        // The document strings point into the buffer, which needs to remain valid until ReadDoc returns
         pugi::xml_document doc;
-        doc.load_string(mei.c_str(), (pugi::parse_comments | pugi::parse_default) & ~pugi::parse_eol);
+        doc.load_buffer_inplace(
+            mei, length, (pugi::parse_comments | pugi::parse_default) & ~pugi::parse_eol, pugi::encoding_utf8);
         pugi::xml_node root = doc.first_child();
         return this->ReadDoc(root);
     }
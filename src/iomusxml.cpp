@@ -113,13 +113,30 @@ MusicXmlInput::~MusicXmlInput() {}
 
 #ifndef NO_MUSICXML_SUPPORT
 
-bool MusicXmlInput::Import(const std::string &musicxml)
+bool MusicXmlInput::Import(std::string_view musicxml)
 {
     try {
         m_doc->Reset();
         m_doc->SetType(Raw);
         pugi::xml_document xmlDoc;
-        xmlDoc.load_string(musicxml.c_str());
+        xmlDoc.load_buffer(musicxml.data(), musicxml.size(), pugi::parse_default, pugi::encoding_utf8);
+        pugi::xml_node root = xmlDoc.first_child();
+        return ReadMusicXml(root);
+    }
+    catch (char *str) {
+        LogError("%s", str);
+        return false;
+    }
+}
+
+bool MusicXmlInput::ImportInPlace(char *musicxml, size_t length)
+{
+    try {
+        m_doc->Reset();
+        m_doc->SetType(Raw);
+        // The document strings point into the buffer, which needs to remain valid until ReadMusicXml returns
+        pugi::xml_document xmlDoc;
+        xmlDoc.load_buffer_inplace(musicxml, length, pugi::parse_default, pugi::encoding_utf8);
         pugi::xml_node root = xmlDoc.first_child();
         return ReadMusicXml(root);
     }
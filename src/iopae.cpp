@@ -652,9 +652,9 @@ jsonxx::Object PAEInput::GetValidationLog()
 
 //////////////////////////////////////////////////////////////////////////
 
-bool PAEInput::Import(const std::string &pae)
+bool PAEInput::Import(std::string_view pae)
 {
-    std::istringstream in_stream(pae);
+    std::istringstream in_stream{ std::string(pae) };
     parsePlainAndEasy(in_stream);
     return true;
 }
@@ -2734,8 +2734,10 @@ bool PAEInput::CheckPAEChars(const std::string &input, std::string &invalidChars
     return status;
 }
 
-bool PAEInput::Import(const std::string &input)
+bool PAEInput::Import(std::string_view inputView)
 {
+    const std::string input(inputView);
+
     this->ClearTokenObjects();
 
     m_inputLog.reset();
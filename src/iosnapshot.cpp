@@ -0,0 +1,839 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        iosnapshot.cpp
+// Author:      Laurent Pugin
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "iosnapshot.h"
+
+//----------------------------------------------------------------------------
+
+#include <cassert>
+#include <cstring>
+#include <set>
+#include <sstream>
+
+//----------------------------------------------------------------------------
+
+#include "app.h"
+#include "att.h"
+#include "choice.h"
+#include "doc.h"
+#include "editorial.h"
+#include "elementpart.h"
+#include "facsimile.h"
+#include "layerelement.h"
+#include "mdiv.h"
+#include "measure.h"
+#include "page.h"
+#include "pagemilestone.h"
+#include "pages.h"
+#include "score.h"
+#include "staff.h"
+#include "stem.h"
+#include "subst.h"
+#include "svg.h"
+#include "system.h"
+#include "systemelement.h"
+#include "systemmilestone.h"
+#include "text.h"
+#include "timestamp.h"
+#include "vrv.h"
+
+//----------------------------------------------------------------------------
+
+#include "pugixml.hpp"
+
+namespace vrv {
+
+/** The size of the header in bytes */
+#define SNAPSHOT_HEADER_SIZE 32
+/** The number of words of an object record before the unsupported attributes and the payload */
+#define SNAPSHOT_RECORD_SIZE 9
+
+/** The flags of an object record */
+enum { SNAPSHOT_FLAG_ATTRIBUTE = 1, SNAPSHOT_FLAG_EXPANSION = 2 };
+
+/**
+ * The classes constructed for each object instead of being cloned from a prototype.
+ * They have no Clone method, except the milestone ends which are constructed with their start.
+ */
+static const std::set<std::string> s_constructedClasses = { "Page", "PageMilestoneEnd", "Pages", "System",
+    "SystemMilestoneEnd", "TimestampAttr", "TupletBracket", "TupletNum", "pgFoot", "pgFoot2", "pgHead", "pgHead2",
+    "score", "svg", "symbolDef", "symbolTable", "tabDurSym", "tabGrp" };
+
+static void AppendWord(std::string &buffer, uint32_t value)
+{
+    const char bytes[4] = { char(value & 0xFF), char((value >> 8) & 0xFF), char((value >> 16) & 0xFF),
+        char((value >> 24) & 0xFF) };
+    buffer.append(bytes, 4);
+}
+
+static uint32_t ReadWord(const unsigned char *data)
+{
+    return uint32_t(data[0]) | (uint32_t(data[1]) << 8) | (uint32_t(data[2]) << 16) | (uint32_t(data[3]) << 24);
+}
+
+static void GetAllAttributes(const Object *object, ArrayOfStrAttr *attributes)
+{
+    Att::GetAnalytical(object, attributes);
+    Att::GetCmn(object, attributes);
+    Att::GetCmnornaments(object, attributes);
+    Att::GetCritapp(object, attributes);
+    Att::GetExternalsymbols(object, attributes);
+    Att::GetFacsimile(object, attributes);
+    Att::GetFrettab(object, attributes);
+    Att::GetGestural(object, attributes);
+    Att::GetMei(object, attributes);
+    Att::GetMensural(object, attributes);
+    Att::GetMidi(object, attributes);
+    Att::GetNeumes(object, attributes);
+    Att::GetPagebased(object, attributes);
+    Att::GetShared(object, attributes);
+    Att::GetUsersymbols(object, attributes);
+    Att::GetVisual(object, attributes);
+}
+
+static bool SetAnyAttribute(Object *object, const std::string &name, const std::string &value)
+{
+    if (Att::SetAnalytical(object, name, value)) return true;
+    if (Att::SetCmn(object, name, value)) return true;
+    if (Att::SetCmnornaments(object, name, value)) return true;
+    if (Att::SetCritapp(object, name, value)) return true;
+    if (Att::SetExternalsymbols(object, name, value)) return true;
+    if (Att::SetFacsimile(object, name, value)) return true;
+    if (Att::SetFrettab(object, name, value)) return true;
+    if (Att::SetGestural(object, name, value)) return true;
+    if (Att::SetMei(object, name, value)) return true;
+    if (Att::SetMensural(object, name, value)) return true;
+    if (Att::SetMidi(object, name, value)) return true;
+    if (Att::SetNeumes(object, name, value)) return true;
+    if (Att::SetPagebased(object, name, value)) return true;
+    if (Att::SetShared(object, name, value)) return true;
+    if (Att::SetUsersymbols(object, name, value)) return true;
+    if (Att::SetVisual(object, name, value)) return true;
+    return false;
+}
+
+static std::string XMLDocumentToString(const pugi::xml_document &document)
+{
+    std::ostringstream stream;
+    document.save(stream, "", pugi::format_raw | pugi::format_no_declaration);
+    return stream.str();
+}
+
+//----------------------------------------------------------------------------
+// SnapshotOutput
+//----------------------------------------------------------------------------
+
+SnapshotOutput::SnapshotOutput(Doc *doc, LayoutInformation layoutInformation) : Output(doc)
+{
+    m_layoutInformation = layoutInformation;
+}
+
+SnapshotOutput::~SnapshotOutput() {}
+
+std::string SnapshotOutput::GetOutput()
+{
+    m_strings.clear();
+    m_stringIndexes.clear();
+    m_attributeSets.clear();
+    m_attributeSetIndexes.clear();
+    m_records.clear();
+    m_objectIndexes.clear();
+
+    // Index 0 is the empty string
+    this->AddString("");
+
+    m_classNames.clear();
+    for (auto &entry : ObjectFactory::GetInstance()->s_classIdsRegistry) {
+        m_classNames[entry.second] = entry.first;
+    }
+
+    this->WriteTree(m_doc);
+    if (m_doc->HasFacsimile()) {
+        this->WriteTree(m_doc->GetFacsimile());
+    }
+
+    // Serialize the string table with offsets relative to the start of the string data
+    std::string stringData;
+    std::vector<uint32_t> stringOffsets;
+    stringOffsets.reserve(m_strings.size() + 1);
+    for (const std::string &string : m_strings) {
+        stringOffsets.push_back((uint32_t)stringData.size());
+        stringData += string;
+    }
+    stringOffsets.push_back((uint32_t)stringData.size());
+    // Pad the string data to keep the following sections aligned on words
+    stringData.resize((stringData.size() + 3) & ~size_t(3), '\0');
+
+    std::string output;
+    output.reserve(SNAPSHOT_HEADER_SIZE + stringData.size()
+        + 4 * (stringOffsets.size() + m_attributeSets.size() + m_records.size()));
+    output.append(SNAPSHOT_SIGNATURE, 8);
+    AppendWord(output, SNAPSHOT_VERSION);
+    AppendWord(output, (uint32_t)m_strings.size());
+    AppendWord(output, (uint32_t)stringData.size());
+    AppendWord(output, (uint32_t)m_attributeSetIndexes.size());
+    AppendWord(output, (uint32_t)m_attributeSets.size());
+    AppendWord(output, (uint32_t)m_records.size());
+    for (uint32_t offset : stringOffsets) AppendWord(output, offset);
+    output += stringData;
+    for (uint32_t word : m_attributeSets) AppendWord(output, word);
+    for (uint32_t word : m_records) AppendWord(output, word);
+
+    return output;
+}
+
+void SnapshotOutput::WriteTree(Object *object)
+{
+    assert(object);
+
+    const uint32_t index = (uint32_t)m_objectIndexes.size();
+    m_objectIndexes[object] = index;
+
+    std::vector<uint32_t> payload;
+    this->WritePayload(object, payload);
+
+    uint32_t flags = 0;
+    if (object->IsAttribute()) flags |= SNAPSHOT_FLAG_ATTRIBUTE;
+    if (object->IsExpansion()) flags |= SNAPSHOT_FLAG_EXPANSION;
+
+    m_records.push_back(this->AddAttributeSet(object));
+    m_records.push_back(this->GetCtorArg(object));
+    m_records.push_back(this->AddString(object->GetID()));
+    m_records.push_back(flags);
+    m_records.push_back((uint32_t)object->GetChildCount());
+    m_records.push_back(this->AddString(object->GetComment()));
+    m_records.push_back(this->AddString(object->GetClosingComment()));
+    m_records.push_back((uint32_t)object->m_unsupported.size());
+    m_records.push_back((uint32_t)payload.size());
+    for (auto &pair : object->m_unsupported) {
+        m_records.push_back(this->AddString(pair.first));
+        m_records.push_back(this->AddString(pair.second));
+    }
+    m_records.insert(m_records.end(), payload.begin(), payload.end());
+
+    // The scoreDef of a score is not a child and is written before the children
+    if (object->Is(SCORE)) {
+        this->WriteTree(vrv_cast<Score *>(object)->GetScoreDef());
+    }
+
+    for (Object *child : object->GetChildren()) {
+        this->WriteTree(child);
+    }
+}
+
+void SnapshotOutput::WritePayload(Object *object, std::vector<uint32_t> &payload)
+{
+    if (object->Is(DOC)) {
+        Doc *doc = vrv_cast<Doc *>(object);
+        assert(doc);
+        payload.push_back(doc->GetType());
+        payload.push_back(doc->m_notationType);
+        payload.push_back(doc->IsMensuralMusicOnly());
+        payload.push_back(doc->GetMarkup());
+        payload.push_back(doc->m_drawingPageWidth);
+        payload.push_back(doc->m_drawingPageHeight);
+        payload.push_back(m_layoutInformation);
+        payload.push_back(this->AddString(XMLDocumentToString(doc->m_header)));
+        payload.push_back(this->AddString(XMLDocumentToString(doc->m_front)));
+        payload.push_back(this->AddString(XMLDocumentToString(doc->m_back)));
+        payload.push_back(doc->HasFacsimile());
+    }
+    else if (object->Is(TEXT)) {
+        Text *text = vrv_cast<Text *>(object);
+        assert(text);
+        payload.push_back(this->AddString(UTF32to8(text->GetText())));
+    }
+    else if (object->Is(PAGE)) {
+        Page *page = vrv_cast<Page *>(object);
+        assert(page);
+        uint64_t ppuFactor;
+        memcpy(&ppuFactor, &page->m_PPUFactor, sizeof(ppuFactor));
+        payload.push_back(page->m_pageWidth);
+        payload.push_back(page->m_pageHeight);
+        payload.push_back(page->m_pageMarginBottom);
+        payload.push_back(page->m_pageMarginLeft);
+        payload.push_back(page->m_pageMarginRight);
+        payload.push_back(page->m_pageMarginTop);
+        payload.push_back(this->AddString(page->m_surface));
+        payload.push_back(uint32_t(ppuFactor & 0xFFFFFFFF));
+        payload.push_back(uint32_t(ppuFactor >> 32));
+    }
+    else if (object->Is(SYSTEM)) {
+        System *system = vrv_cast<System *>(object);
+        assert(system);
+        payload.push_back(system->m_systemLeftMar);
+        payload.push_back(system->m_systemRightMar);
+        payload.push_back(system->m_yAbs);
+        payload.push_back(system->m_xAbs);
+    }
+    else if (object->Is(MEASURE)) {
+        Measure *measure = vrv_cast<Measure *>(object);
+        assert(measure);
+        payload.push_back(measure->m_xAbs);
+        payload.push_back(measure->m_xAbs2);
+    }
+    else if (object->Is(STAFF)) {
+        Staff *staff = vrv_cast<Staff *>(object);
+        assert(staff);
+        payload.push_back(staff->m_yAbs);
+    }
+    else if (object->Is(SVG)) {
+        Svg *svg = vrv_cast<Svg *>(object);
+        assert(svg);
+        pugi::xml_document document;
+        document.append_copy(svg->Get());
+        payload.push_back(this->AddString(XMLDocumentToString(document)));
+    }
+    else if (object->IsLayerElement()) {
+        LayerElement *layerElement = vrv_cast<LayerElement *>(object);
+        assert(layerElement);
+        payload.push_back(layerElement->m_xAbs);
+    }
+    else if (object->IsEditorialElement()) {
+        EditorialElement *editorialElement = vrv_cast<EditorialElement *>(object);
+        assert(editorialElement);
+        payload.push_back(editorialElement->m_visibility);
+    }
+    else if (object->Is(MDIV)) {
+        Mdiv *mdiv = vrv_cast<Mdiv *>(object);
+        assert(mdiv);
+        payload.push_back(mdiv->m_visibility);
+    }
+    else if (object->IsSystemElement()) {
+        SystemElement *systemElement = vrv_cast<SystemElement *>(object);
+        assert(systemElement);
+        payload.push_back(systemElement->m_visibility);
+    }
+}
+
+uint32_t SnapshotOutput::GetCtorArg(Object *object) const
+{
+    const Object *start = NULL;
+    if (object->Is(MEASURE)) {
+        return vrv_cast<Measure *>(object)->IsMeasuredMusic();
+    }
+    else if (object->Is(APP)) {
+        return vrv_cast<App *>(object)->GetLevel();
+    }
+    else if (object->Is(CHOICE)) {
+        return vrv_cast<Choice *>(object)->GetLevel();
+    }
+    else if (object->Is(SUBST)) {
+        return vrv_cast<Subst *>(object)->GetLevel();
+    }
+    else if (object->Is(PAGE_MILESTONE_END)) {
+        start = vrv_cast<PageMilestoneEnd *>(object)->GetStart();
+    }
+    else if (object->Is(SYSTEM_MILESTONE_END)) {
+        start = vrv_cast<SystemMilestoneEnd *>(object)->GetStart();
+    }
+    else {
+        return 0;
+    }
+
+    // The start of a milestone end is always written before it
+    assert(start);
+    auto iter = m_objectIndexes.find(start);
+    assert(iter != m_objectIndexes.end());
+    return iter->second;
+}
+
+uint32_t SnapshotOutput::AddString(const std::string &string)
+{
+    auto iter = m_stringIndexes.find(string);
+    if (iter != m_stringIndexes.end()) return iter->second;
+
+    const uint32_t index = (uint32_t)m_strings.size();
+    m_strings.push_back(string);
+    m_stringIndexes[string] = index;
+    return index;
+}
+
+uint32_t SnapshotOutput::AddAttributeSet(Object *object)
+{
+    ArrayOfStrAttr attributes;
+    GetAllAttributes(object, &attributes);
+
+    // Use the name registered in the factory and the class name for classes not registered
+    std::vector<uint32_t> attributeSet;
+    auto iter = m_classNames.find(object->GetClassId());
+    const std::string &className = (iter != m_classNames.end()) ? iter->second : object->GetClassName();
+    attributeSet.push_back(this->AddString(className));
+    attributeSet.push_back((uint32_t)attributes.size());
+    for (auto &pair : attributes) {
+        attributeSet.push_back(this->AddString(pair.first));
+        attributeSet.push_back(this->AddString(pair.second));
+    }
+
+    auto setIter = m_attributeSetIndexes.find(attributeSet);
+    if (setIter != m_attributeSetIndexes.end()) return setIter->second;
+
+    const uint32_t index = (uint32_t)m_attributeSetIndexes.size();
+    m_attributeSetIndexes[attributeSet] = index;
+    m_attributeSets.insert(m_attributeSets.end(), attributeSet.begin(), attributeSet.end());
+    return index;
+}
+
+//----------------------------------------------------------------------------
+// SnapshotInput
+//----------------------------------------------------------------------------
+
+SnapshotInput::SnapshotInput(Doc *doc) : Input(doc)
+{
+    m_data = NULL;
+    m_stringCount = 0;
+    m_stringOffsets = NULL;
+    m_stringData = NULL;
+    m_attributeSets = NULL;
+    m_position = NULL;
+    m_end = NULL;
+    m_hasFacsimile = false;
+}
+
+SnapshotInput::~SnapshotInput()
+{
+    for (auto &entry : m_prototypes) {
+        delete entry.second;
+    }
+}
+
+bool SnapshotInput::IsSnapshot(std::string_view data)
+{
+    return ((data.size() >= 8) && (memcmp(data.data(), SNAPSHOT_SIGNATURE, 8) == 0));
+}
+
+bool SnapshotInput::Import(std::string_view data)
+{
+    if (!SnapshotInput::IsSnapshot(data) || (data.size() < SNAPSHOT_HEADER_SIZE)) {
+        LogError("The data is not a valid snapshot");
+        return false;
+    }
+
+    m_data = reinterpret_cast<const unsigned char *>(data.data());
+    const uint32_t version = ReadWord(m_data + 8);
+    if (version != SNAPSHOT_VERSION) {
+        LogError("The snapshot version %d is not supported (expected %d)", version, SNAPSHOT_VERSION);
+        return false;
+    }
+    m_stringCount = ReadWord(m_data + 12);
+    const uint64_t stringDataSize = ReadWord(m_data + 16);
+    const uint32_t attributeSetCount = ReadWord(m_data + 20);
+    const uint64_t attributeSetSize = ReadWord(m_data + 24);
+    const uint64_t recordSize = ReadWord(m_data + 28);
+
+    // Check the size of the sections against the size of the data
+    const uint64_t expectedSize = SNAPSHOT_HEADER_SIZE + 4 * (uint64_t(m_stringCount) + 1) + stringDataSize
+        + 4 * (attributeSetSize + recordSize);
+    if ((m_stringCount == 0) || (expectedSize != data.size())) {
+        LogError("The snapshot is truncated or corrupted");
+        return false;
+    }
+
+    m_stringOffsets = m_data + SNAPSHOT_HEADER_SIZE;
+    m_stringData = reinterpret_cast<const char *>(m_stringOffsets + 4 * (m_stringCount + 1));
+    for (uint32_t i = 0; i < m_stringCount; ++i) {
+        const uint32_t offset = ReadWord(m_stringOffsets + 4 * i);
+        const uint32_t next = ReadWord(m_stringOffsets + 4 * (i + 1));
+        if ((offset > next) || (next > stringDataSize)) {
+            LogError("The snapshot string table is corrupted");
+            return false;
+        }
+    }
+
+    // Index the attribute sets and validate the indexes of strings they contain
+    const unsigned char *attributeSets = reinterpret_cast<const unsigned char *>(m_stringData) + stringDataSize;
+    m_attributeSetOffsets.clear();
+    m_attributeSetOffsets.reserve(attributeSetCount);
+    uint64_t offset = 0;
+    for (uint32_t i = 0; i < attributeSetCount; ++i) {
+        if (offset + 2 > attributeSetSize) break;
+        const uint32_t count = ReadWord(attributeSets + 4 * (offset + 1));
+        if (offset + 2 + 2 * uint64_t(count) > attributeSetSize) break;
+        for (uint64_t j = 0; j < 2 * uint64_t(count) + 1; ++j) {
+            if (ReadWord(attributeSets + 4 * (offset + (j == 0 ? 0 : j + 1))) >= m_stringCount) {
+                LogError("The snapshot attribute table is corrupted");
+                return false;
+            }
+        }
+        m_attributeSetOffsets.push_back((uint32_t)offset);
+        offset += 2 + 2 * uint64_t(count);
+    }
+    if ((m_attributeSetOffsets.size() != attributeSetCount) || (offset != attributeSetSize)) {
+        LogError("The snapshot attribute table is corrupted");
+        return false;
+    }
+
+    m_attributeSets = attributeSets;
+    m_position = attributeSets + 4 * attributeSetSize;
+    m_end = m_position + 4 * recordSize;
+
+    m_doc->Reset();
+    m_objects.clear();
+    m_hasFacsimile = false;
+
+    if (!this->ReadTree(NULL, m_doc)) {
+        m_doc->Reset();
+        return false;
+    }
+    if (m_hasFacsimile) {
+        Object *facsimile = this->ReadTree(NULL);
+        if (!facsimile || !facsimile->Is(FACSIMILE)) {
+            LogError("The snapshot facsimile is corrupted");
+            if (facsimile) delete facsimile;
+            m_doc->Reset();
+            return false;
+        }
+        m_doc->SetFacsimile(vrv_cast<Facsimile *>(facsimile));
+    }
+    if (m_position != m_end) {
+        LogWarning("The snapshot has unexpected trailing data");
+    }
+
+    return true;
+}
+
+Object *SnapshotInput::ReadTree(Object *parent, Object *target)
+{
+    const unsigned char *record = NULL;
+    if (!this->ReadWords(SNAPSHOT_RECORD_SIZE, record)) return NULL;
+
+    const uint32_t attributeSet = this->GetWord(record, 0);
+    const uint32_t ctorArg = this->GetWord(record, 1);
+    const uint32_t id = this->GetWord(record, 2);
+    const uint32_t flags = this->GetWord(record, 3);
+    const uint32_t childCount = this->GetWord(record, 4);
+    const uint32_t comment = this->GetWord(record, 5);
+    const uint32_t closingComment = this->GetWord(record, 6);
+    const uint32_t unsupportedCount = this->GetWord(record, 7);
+    const uint32_t payloadCount = this->GetWord(record, 8);
+
+    if ((attributeSet >= m_attributeSetOffsets.size()) || (id >= m_stringCount) || (comment >= m_stringCount)
+        || (closingComment >= m_stringCount)) {
+        LogError("The snapshot object table is corrupted");
+        return NULL;
+    }
+
+    // The pairs of unsupported attributes cannot be more than the words left
+    if (uint64_t(unsupportedCount) * 2 > uint64_t(m_end - m_position) / 4) {
+        LogError("The snapshot object table is truncated");
+        return NULL;
+    }
+    const unsigned char *unsupported = NULL;
+    const unsigned char *payload = NULL;
+    if (!this->ReadWords(2 * unsupportedCount, unsupported) || !this->ReadWords(payloadCount, payload)) {
+        return NULL;
+    }
+    for (uint32_t i = 0; i < 2 * unsupportedCount; ++i) {
+        if (this->GetWord(unsupported, i) >= m_stringCount) {
+            LogError("The snapshot object table is corrupted");
+            return NULL;
+        }
+    }
+
+    Object *object = target;
+    if (object) {
+        this->SetAttributes(object, attributeSet);
+    }
+    else {
+        object = this->CreateObject(attributeSet, ctorArg);
+        if (!object) return NULL;
+        // The children are already in order and of supported classes
+        if (parent) {
+            object->SetParent(parent);
+            parent->GetChildrenForModification().push_back(object);
+        }
+    }
+    m_objects.push_back(object);
+
+    object->SetID(std::string(this->GetString(id)));
+    if (comment) object->SetComment(std::string(this->GetString(comment)));
+    if (closingComment) object->SetClosingComment(std::string(this->GetString(closingComment)));
+    object->IsAttribute(flags & SNAPSHOT_FLAG_ATTRIBUTE);
+    object->IsExpansion(flags & SNAPSHOT_FLAG_EXPANSION);
+    for (uint32_t i = 0; i < unsupportedCount; ++i) {
+        object->m_unsupported.push_back({ std::string(this->GetString(this->GetWord(unsupported, 2 * i))),
+            std::string(this->GetString(this->GetWord(unsupported, 2 * i + 1))) });
+    }
+
+    bool success = this->ReadPayload(object, payload, payloadCount);
+
+    if (success && object->Is(SCORE)) {
+        success = this->ReadTree(NULL, vrv_cast<Score *>(object)->GetScoreDef());
+    }
+
+    for (uint32_t i = 0; success && (i < childCount); ++i) {
+        success = this->ReadTree(object);
+    }
+
+    if (!success) {
+        // Objects added to a parent are deleted with it
+        if (!target && !parent) delete object;
+        return NULL;
+    }
+
+    return object;
+}
+
+Object *SnapshotInput::CreateObject(uint32_t attributeSet, uint32_t ctorArg)
+{
+    const std::string className(this->GetString(this->GetWord(m_attributeSets, m_attributeSetOffsets[attributeSet])));
+
+    if (s_constructedClasses.count(className)) {
+        Object *object = this->ConstructObject(className, ctorArg);
+        if (object) this->SetAttributes(object, attributeSet);
+        return object;
+    }
+
+    // Otherwise clone the prototype for the attribute set, which is created the first time
+    Object *prototype = NULL;
+    const std::pair<uint32_t, uint32_t> key = { attributeSet, ctorArg };
+    auto iter = m_prototypes.find(key);
+    if (iter != m_prototypes.end()) {
+        prototype = iter->second;
+    }
+    else {
+        prototype = this->ConstructObject(className, ctorArg);
+        if (!prototype) return NULL;
+        this->SetAttributes(prototype, attributeSet);
+        m_prototypes[key] = prototype;
+    }
+
+    Object *object = prototype->Clone();
+    assert(object);
+    object->CloneReset();
+    return object;
+}
+
+Object *SnapshotInput::ConstructObject(const std::string &className, uint32_t ctorArg)
+{
+    if (className == "PageMilestoneEnd" || className == "SystemMilestoneEnd") {
+        if (ctorArg >= m_objects.size()) {
+            LogError("The snapshot milestone start is corrupted");
+            return NULL;
+        }
+        Object *start = m_objects.at(ctorArg);
+        if (className == "PageMilestoneEnd") {
+            PageMilestoneInterface *interface = dynamic_cast<PageMilestoneInterface *>(start);
+            if (!interface) return NULL;
+            PageMilestoneEnd *end = new PageMilestoneEnd(start);
+            interface->SetEnd(end);
+            return end;
+        }
+        else {
+            SystemMilestoneInterface *interface = dynamic_cast<SystemMilestoneInterface *>(start);
+            if (!interface) return NULL;
+            SystemMilestoneEnd *end = new SystemMilestoneEnd(start);
+            interface->SetEnd(end);
+            return end;
+        }
+    }
+    else if (className == "measure") {
+        return new Measure(ctorArg != 0);
+    }
+    else if (className == "app") {
+        return new App((EditorialLevel)ctorArg);
+    }
+    else if (className == "choice") {
+        return new Choice((EditorialLevel)ctorArg);
+    }
+    else if (className == "subst") {
+        return new Subst((EditorialLevel)ctorArg);
+    }
+    // Classes not registered in the factory
+    else if (className == "Dots") {
+        return new Dots();
+    }
+    else if (className == "Flag") {
+        return new Flag();
+    }
+    else if (className == "Page") {
+        return new Page();
+    }
+    else if (className == "Pages") {
+        return new Pages();
+    }
+    else if (className == "Stem") {
+        return new Stem();
+    }
+    else if (className == "System") {
+        return new System();
+    }
+    else if (className == "Text") {
+        return new Text();
+    }
+    else if (className == "TimestampAttr") {
+        return new TimestampAttr();
+    }
+    else if (className == "TupletBracket") {
+        return new TupletBracket();
+    }
+    else if (className == "TupletNum") {
+        return new TupletNum();
+    }
+
+    auto &registry = ObjectFactory::GetInstance()->s_ctorsRegistry;
+    auto iter = registry.find(className);
+    if (iter == registry.end()) {
+        LogError("The snapshot class '%s' is not supported", className.c_str());
+        return NULL;
+    }
+    return iter->second();
+}
+
+void SnapshotInput::SetAttributes(Object *object, uint32_t attributeSet)
+{
+    const uint32_t offset = m_attributeSetOffsets[attributeSet];
+    const uint32_t count = this->GetWord(m_attributeSets, offset + 1);
+    for (uint32_t i = 0; i < count; ++i) {
+        const std::string name(this->GetString(this->GetWord(m_attributeSets, offset + 2 + 2 * i)));
+        const std::string value(this->GetString(this->GetWord(m_attributeSets, offset + 3 + 2 * i)));
+        if (!SetAnyAttribute(object, name, value)) {
+            LogWarning("Attribute '%s' for '%s' could not be restored", name.c_str(), object->GetClassName().c_str());
+        }
+    }
+}
+
+bool SnapshotInput::ReadPayload(Object *object, const unsigned char *payload, uint32_t count)
+{
+    std::vector<uint32_t> values(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        values[i] = this->GetWord(payload, i);
+    }
+    auto checkCount = [&values](size_t expected) {
+        if (values.size() == expected) return true;
+        LogError("The snapshot object payload is corrupted");
+        return false;
+    };
+    auto getString = [this](uint32_t index) {
+        return (index < m_stringCount) ? std::string(this->GetString(index)) : std::string();
+    };
+
+    if (object->Is(DOC)) {
+        if (!checkCount(11)) return false;
+        Doc *doc = vrv_cast<Doc *>(object);
+        assert(doc);
+        doc->SetType((DocType)values[0]);
+        doc->m_notationType = (data_NOTATIONTYPE)values[1];
+        doc->SetMensuralMusicOnly(values[2]);
+        doc->SetMarkup(values[3]);
+        doc->m_drawingPageWidth = values[4];
+        doc->m_drawingPageHeight = values[5];
+        m_layoutInformation = (LayoutInformation)values[6];
+        const unsigned int parseOptions
+            = pugi::parse_default | pugi::parse_comments | pugi::parse_pi | pugi::parse_ws_pcdata;
+        doc->m_header.load_string(getString(values[7]).c_str(), parseOptions);
+        doc->m_front.load_string(getString(values[8]).c_str(), parseOptions);
+        doc->m_back.load_string(getString(values[9]).c_str(), parseOptions);
+        // The facsimile is read after the document
+        m_hasFacsimile = values[10];
+    }
+    else if (object->Is(TEXT)) {
+        if (!checkCount(1)) return false;
+        Text *text = vrv_cast<Text *>(object);
+        assert(text);
+        text->SetText(UTF8to32(getString(values[0])));
+    }
+    else if (object->Is(PAGE)) {
+        if (!checkCount(9)) return false;
+        Page *page = vrv_cast<Page *>(object);
+        assert(page);
+        page->m_pageWidth = values[0];
+        page->m_pageHeight = values[1];
+        page->m_pageMarginBottom = values[2];
+        page->m_pageMarginLeft = values[3];
+        page->m_pageMarginRight = values[4];
+        page->m_pageMarginTop = values[5];
+        page->m_surface = getString(values[6]);
+        const uint64_t ppuFactor = uint64_t(values[7]) | (uint64_t(values[8]) << 32);
+        memcpy(&page->m_PPUFactor, &ppuFactor, sizeof(ppuFactor));
+    }
+    else if (object->Is(SYSTEM)) {
+        if (!checkCount(4)) return false;
+        System *system = vrv_cast<System *>(object);
+        assert(system);
+        system->m_systemLeftMar = values[0];
+        system->m_systemRightMar = values[1];
+        system->m_yAbs = values[2];
+        system->m_xAbs = values[3];
+    }
+    else if (object->Is(MEASURE)) {
+        if (!checkCount(2)) return false;
+        Measure *measure = vrv_cast<Measure *>(object);
+        assert(measure);
+        measure->m_xAbs = values[0];
+        measure->m_xAbs2 = values[1];
+    }
+    else if (object->Is(STAFF)) {
+        if (!checkCount(1)) return false;
+        Staff *staff = vrv_cast<Staff *>(object);
+        assert(staff);
+        staff->m_yAbs = values[0];
+    }
+    else if (object->Is(SVG)) {
+        if (!checkCount(1)) return false;
+        Svg *svg = vrv_cast<Svg *>(object);
+        assert(svg);
+        pugi::xml_document document;
+        document.load_string(getString(values[0]).c_str(), pugi::parse_default | pugi::parse_ws_pcdata);
+        svg->Set(document.first_child());
+    }
+    else if (object->IsLayerElement()) {
+        if (!checkCount(1)) return false;
+        LayerElement *layerElement = vrv_cast<LayerElement *>(object);
+        assert(layerElement);
+        layerElement->m_xAbs = values[0];
+    }
+    else if (object->IsEditorialElement()) {
+        if (!checkCount(1)) return false;
+        EditorialElement *editorialElement = vrv_cast<EditorialElement *>(object);
+        assert(editorialElement);
+        editorialElement->m_visibility = (VisibilityType)values[0];
+    }
+    else if (object->Is(MDIV)) {
+        if (!checkCount(1)) return false;
+        Mdiv *mdiv = vrv_cast<Mdiv *>(object);
+        assert(mdiv);
+        mdiv->m_visibility = (VisibilityType)values[0];
+    }
+    else if (object->IsSystemElement()) {
+        if (!checkCount(1)) return false;
+        SystemElement *systemElement = vrv_cast<SystemElement *>(object);
+        assert(systemElement);
+        systemElement->m_visibility = (VisibilityType)values[0];
+    }
+    else if (!checkCount(0)) {
+        return false;
+    }
+    return true;
+}
+
+bool SnapshotInput::ReadWords(uint32_t count, const unsigned char *&words)
+{
+    if (uint64_t(m_end - m_position) < 4 * uint64_t(count)) {
+        LogError("The snapshot object table is truncated");
+        return false;
+    }
+    words = m_position;
+    m_position += 4 * uint64_t(count);
+    return true;
+}
+
+uint32_t SnapshotInput::GetWord(const unsigned char *words, uint32_t index) const
+{
+    return ReadWord(words + 4 * uint64_t(index));
+}
+
+std::string_view SnapshotInput::GetString(uint32_t index) const
+{
+    // All the indexes are checked against the string table when reading the snapshot
+    assert(index < m_stringCount);
+    const uint32_t offset = ReadWord(m_stringOffsets + 4 * index);
+    const uint32_t next = ReadWord(m_stringOffsets + 4 * (index + 1));
+    return std::string_view(m_stringData + offset, next - offset);
+}
+
+} // namespace vrv
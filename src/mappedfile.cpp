@@ -0,0 +1,108 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        mappedfile.cpp
+// Author:      Laurent Pugin
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "mappedfile.h"
+
+//----------------------------------------------------------------------------
+
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//----------------------------------------------------------------------------
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// MappedFile
+//----------------------------------------------------------------------------
+
+MappedFile::MappedFile()
+{
+    m_data = NULL;
+    m_size = 0;
+    m_isOpen = false;
+    m_isMapped = false;
+}
+
+MappedFile::~MappedFile()
+{
+    this->Close();
+}
+
+bool MappedFile::Open(const std::string &filename)
+{
+    this->Close();
+
+#ifndef _WIN32
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat fileStat;
+    if ((fstat(fd, &fileStat) != 0) || !S_ISREG(fileStat.st_mode)) {
+        close(fd);
+        return false;
+    }
+
+    m_size = (size_t)fileStat.st_size;
+    if (m_size > 0) {
+        // Private writable mapping - pages are copied on write and changes are never written back to the file
+        void *data = mmap(NULL, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            m_data = static_cast<char *>(data);
+            m_isMapped = true;
+        }
+    }
+    close(fd);
+    if (m_size > 0 && !m_isMapped) {
+        m_size = 0;
+        // Fall back to reading the file into the buffer
+    }
+    else {
+        m_isOpen = true;
+        return true;
+    }
+#endif
+
+    std::ifstream in(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!in.is_open()) return false;
+
+    in.seekg(0, std::ios::end);
+    std::streamsize fileSize = (std::streamsize)in.tellg();
+    in.seekg(0, std::ios::beg);
+    if (fileSize < 0) return false;
+
+    m_buffer.resize(fileSize);
+    in.read(m_buffer.data(), fileSize);
+    m_data = (fileSize > 0) ? m_buffer.data() : NULL;
+    m_size = (size_t)fileSize;
+    m_isOpen = true;
+
+    return true;
+}
+
+void MappedFile::Close()
+{
+#ifndef _WIN32
+    if (m_isMapped) {
+        munmap(m_data, m_size);
+    }
+#endif
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+    m_data = NULL;
+    m_size = 0;
+    m_isOpen = false;
+    m_isMapped = false;
+}
+
+} // namespace vrv
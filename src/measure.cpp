@@ -15,6 +15,7 @@
 
 //----------------------------------------------------------------------------
 
+#include "accid.h"
 #include "comparison.h"
 #include "controlelement.h"
 #include "doc.h"
@@ -25,6 +26,7 @@
 #include "hairpin.h"
 #include "harm.h"
 #include "multirest.h"
+#include "note.h"
 #include "page.h"
 #include "pages.h"
 #include "pedal.h"
@@ -379,6 +381,16 @@ int Measure::GetDrawingOverflow()
     return std::max(0, overflow);
 }
 
+int Measure::GetCastOffWidth() const
+{
+    return (this->HasCachedHorizontalLayout()) ? m_cachedWidth : this->GetWidth();
+}
+
+int Measure::GetCastOffOverflow()
+{
+    return (this->HasCachedHorizontalLayout()) ? m_cachedOverflow : this->GetDrawingOverflow();
+}
+
 int Measure::GetSectionRestartShift(const Doc *doc) const
 {
     if (this->IsFirstInSystem()) {
@@ -679,6 +691,151 @@ std::vector<std::pair<LayerElement *, LayerElement *>> Measure::GetInternalTieEn
     return endpoints;
 }
 
+bool Measure::CalcHorizontalLayoutSignature(std::vector<int> &signature)
+{
+    signature.clear();
+
+    // The adjustment of multiple layers depends on too many element properties to be captured in the signature
+    if (m_hasAlignmentRefWithMultipleLayers) return false;
+    // The minimum width of multi-rests depends on their attributes
+    if (this->FindDescendantByType(MULTIREST)) return false;
+
+    Doc *doc = vrv_cast<Doc *>(this->GetFirstAncestor(DOC));
+    assert(doc);
+    System *system = vrv_cast<System *>(this->GetFirstAncestor(SYSTEM));
+    assert(system);
+
+    // The context of the measure in the system, as used by Measure::AdjustXPos
+    const bool isFirstInSystem = this->IsFirstInSystem();
+    signature.push_back(isFirstInSystem);
+    signature.push_back(isFirstInSystem && system->GetDrawingScoreDef()->HasSystemStartLine());
+    signature.push_back(this->GetMetcon());
+    for (int staffN : doc->GetCurrentScoreDef()->GetStaffNs()) {
+        StaffAlignment *staffAlignment = system->m_systemAligner.GetStaffAlignmentForStaffN(staffN);
+        signature.push_back((staffAlignment) ? staffAlignment->GetStaffSize() : 100);
+    }
+
+    // The alignments and their references
+    std::vector<LayerElement *> elements;
+    std::map<const Object *, int> elementIndexes;
+    for (Object *child : m_measureAligner.GetChildren()) {
+        Alignment *alignment = vrv_cast<Alignment *>(child);
+        assert(alignment);
+        // The grace aligners are not part of the measure aligner children
+        if (alignment->GetType() == ALIGNMENT_GRACENOTE) return false;
+        signature.push_back(alignment->GetType());
+        signature.push_back(alignment->GetXRel());
+        signature.push_back(alignment->GetChildCount());
+        for (Object *referenceChild : alignment->GetChildren()) {
+            AlignmentReference *reference = vrv_cast<AlignmentReference *>(referenceChild);
+            assert(reference);
+            if (reference->HasCrossStaffElements()) return false;
+            signature.push_back(reference->GetN());
+            signature.push_back(reference->GetChildCount());
+            for (Object *object : reference->GetChildren()) {
+                LayerElement *element = vrv_cast<LayerElement *>(object);
+                assert(element);
+                elementIndexes[element] = (int)elements.size();
+                elements.push_back(element);
+            }
+        }
+    }
+
+    // Return the index of an aligned element, or -1
+    auto getIndex = [&elementIndexes](const Object *object) {
+        auto iter = elementIndexes.find(object);
+        return (iter != elementIndexes.end()) ? iter->second : -1;
+    };
+
+    // The aligned elements with their bounding boxes (which are relative to their position)
+    for (LayerElement *element : elements) {
+        signature.push_back(element->GetClassId());
+        signature.push_back(getIndex(element->GetParent()));
+        signature.push_back(element->GetAlignmentLayerN());
+        signature.push_back(element->IsScoreDefElement());
+        signature.push_back(element->HasSameasLink());
+        signature.push_back(element->GetDrawingXRel());
+        signature.push_back(element->GetDrawingYRel());
+        signature.push_back(element->HasSelfBB());
+        if (element->HasSelfBB()) {
+            signature.insert(signature.end(),
+                { element->GetSelfX1(), element->GetSelfX2(), element->GetSelfY1(), element->GetSelfY2() });
+        }
+        signature.push_back(element->HasContentBB());
+        if (element->HasContentBB()) {
+            signature.insert(signature.end(),
+                { element->GetContentX1(), element->GetContentX2(), element->GetContentY1(),
+                    element->GetContentY2() });
+        }
+        if (element->Is(BARLINE)) {
+            BarLine *barLine = vrv_cast<BarLine *>(element);
+            assert(barLine);
+            signature.push_back((int)barLine->GetPosition());
+        }
+        // Accidentals with the same pitch in different octaves are aligned by AlignmentReference::AdjustAccidX
+        else if (element->Is(ACCID)) {
+            Accid *accid = vrv_cast<Accid *>(element);
+            assert(accid);
+            signature.push_back(accid->GetAccid());
+            Note *note = vrv_cast<Note *>(accid->GetFirstAncestor(NOTE));
+            signature.push_back((note) ? note->GetPname() : -1);
+            signature.push_back((note) ? note->GetOct() : -1);
+            signature.push_back(getIndex(accid->GetFirstAncestor(CHORD)));
+        }
+    }
+
+    // The ties within the measure, for which a minimal length is ensured
+    for (const auto &endpoints : this->GetInternalTieEndpoints()) {
+        signature.push_back(getIndex(endpoints.first));
+        signature.push_back(getIndex(endpoints.second));
+    }
+
+    return true;
+}
+
+void Measure::GetHorizontalLayoutPositions(std::vector<int> &positions) const
+{
+    positions.clear();
+
+    std::vector<int> elementPositions;
+    for (Object *child : m_measureAligner.GetChildren()) {
+        Alignment *alignment = vrv_cast<Alignment *>(child);
+        assert(alignment);
+        positions.push_back(alignment->GetXRel());
+        for (Object *reference : alignment->GetChildren()) {
+            for (Object *object : reference->GetChildren()) {
+                LayerElement *element = vrv_cast<LayerElement *>(object);
+                assert(element);
+                elementPositions.push_back(element->GetDrawingXRel());
+            }
+        }
+    }
+    positions.insert(positions.end(), elementPositions.begin(), elementPositions.end());
+}
+
+void Measure::SetHorizontalLayoutPositions(const std::vector<int> &positions)
+{
+    std::vector<int>::const_iterator alignmentIter = positions.begin();
+    std::vector<int>::const_iterator elementIter = positions.begin() + m_measureAligner.GetChildCount();
+    for (Object *child : m_measureAligner.GetChildren()) {
+        Alignment *alignment = vrv_cast<Alignment *>(child);
+        assert(alignment);
+        assert(alignmentIter != positions.end());
+        alignment->SetXRel(*alignmentIter);
+        ++alignmentIter;
+        for (Object *reference : alignment->GetChildren()) {
+            for (Object *object : reference->GetChildren()) {
+                LayerElement *element = vrv_cast<LayerElement *>(object);
+                assert(element);
+                assert(elementIter != positions.end());
+                element->SetDrawingXRel(*elementIter);
+                ++elementIter;
+            }
+        }
+    }
+    assert(elementIter == positions.end());
+}
+
 //----------------------------------------------------------------------------
 // Measure functor methods
 //----------------------------------------------------------------------------
@@ -1236,14 +1393,19 @@ int Measure::CastOffSystems(FunctorParams *functorParams)
     CastOffSystemsParams *params = vrv_params_cast<CastOffSystemsParams *>(functorParams);
     assert(params);
 
-    const bool hasCache = this->HasCachedHorizontalLayout();
-    int overflow = hasCache ? this->m_cachedOverflow : this->GetDrawingOverflow();
-    int width = hasCache ? this->m_cachedWidth : this->GetWidth();
+    int overflow = this->GetCastOffOverflow();
+    int width = this->GetCastOffWidth();
     int drawingXRel = this->m_drawingXRel;
 
     Object *nextMeasure = params->m_contentSystem->GetNext(this, MEASURE);
+    // This applies to the optimal breaks too, where the last measure starts a system only if the breaks calculated
+    // in System::CalcOptimalBreaks put it on its own
     const bool isLeftoverMeasure = ((NULL == nextMeasure) && params->m_doc->GetOptions()->m_breaksNoWidow.GetValue()
         && (params->m_doc->GetOptions()->m_breaks.GetValue() != BREAKS_encoded));
+    // With optimal breaks, the measures starting a system were calculated in System::CastOffSystems
+    const bool breakSystem = (params->m_optimal)
+        ? (params->m_breakMeasures.count(this) > 0)
+        : (drawingXRel + width + params->m_currentScoreDefWidth - params->m_shift > params->m_systemWidth);
     if (params->m_currentSystem->GetChildCount() > 0) {
         // We have overflowing content (dir, dynam, tempo) larger than 5 units, keep it as pending
         if (overflow > (params->m_doc->GetDrawingUnit(100) * 5)) {
@@ -1255,7 +1417,7 @@ int Measure::CastOffSystems(FunctorParams *functorParams)
             return FUNCTOR_SIBLINGS;
         }
         // Break it if necessary
-        else if (drawingXRel + width + params->m_currentScoreDefWidth - params->m_shift > params->m_systemWidth) {
+        else if (breakSystem) {
             params->m_currentSystem = new System();
             params->m_page->AddChild(params->m_currentSystem);
             params->m_shift = drawingXRel;
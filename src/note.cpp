@@ -366,15 +366,8 @@ Point Note::GetStemUpSE(const Doc *doc, int staffSize, bool isCueSize) const
         p.x = doc->GetGlyphWidth(code, staffSize, isCueSize);
     }
 
-    const Resources &resources = doc->GetResources();
-    const Glyph *glyph = resources.GetGlyph(code);
-    assert(glyph);
-
-    if (glyph->HasAnchor(SMUFL_stemUpSE)) {
-        const Point *anchor = glyph->GetAnchor(SMUFL_stemUpSE);
-        assert(anchor);
-        p = doc->ConvertFontPoint(glyph, *anchor, staffSize, isCueSize);
-    }
+    // Use the anchor if the glyph has one
+    doc->GetGlyphAnchor(code, SMUFL_stemUpSE, staffSize, isCueSize, p);
 
     return p;
 }
@@ -398,15 +391,8 @@ Point Note::GetStemDownNW(const Doc *doc, int staffSize, bool isCueSize) const
         p.x = doc->GetGlyphWidth(code, staffSize, isCueSize);
     }
 
-    const Resources &resources = doc->GetResources();
-    const Glyph *glyph = resources.GetGlyph(code);
-    assert(glyph);
-
-    if (glyph->HasAnchor(SMUFL_stemDownNW)) {
-        const Point *anchor = glyph->GetAnchor(SMUFL_stemDownNW);
-        assert(anchor);
-        p = doc->ConvertFontPoint(glyph, *anchor, staffSize, isCueSize);
-    }
+    // Use the anchor if the glyph has one
+    doc->GetGlyphAnchor(code, SMUFL_stemDownNW, staffSize, isCueSize, p);
 
     return p;
 }
@@ -22,7 +22,7 @@
 namespace vrv {
 
 const std::map<int, std::string> Option::s_breaks = { { BREAKS_none, "none" }, { BREAKS_auto, "auto" },
-    { BREAKS_line, "line" }, { BREAKS_smart, "smart" }, { BREAKS_encoded, "encoded" } };
+    { BREAKS_line, "line" }, { BREAKS_smart, "smart" }, { BREAKS_encoded, "encoded" }, { BREAKS_optimal, "optimal" } };
 
 const std::map<int, std::string> Option::s_condense
     = { { CONDENSE_none, "none" }, { CONDENSE_auto, "auto" }, { CONDENSE_encoded, "encoded" } };
@@ -887,6 +887,20 @@ Options::Options()
     m_standardOutput.SetShortOption(' ', true);
     m_baseOptions.AddOption(&m_standardOutput);
 
+    m_server.SetInfo("Server", "Process JSON requests (one per line) from the standard input, or from a UNIX socket "
+                               "with \"--server=<socket>\"");
+    m_server.Init("");
+    m_server.SetKey("server");
+    m_server.SetShortOption(' ', true);
+    m_baseOptions.AddOption(&m_server);
+
+    m_serverDocuments.SetInfo(
+        "Server documents", "Maximum number of documents kept loaded in server mode (least recently used evicted)");
+    m_serverDocuments.Init(16, 1, 1024);
+    m_serverDocuments.SetKey("serverDocuments");
+    m_serverDocuments.SetShortOption(' ', true);
+    m_baseOptions.AddOption(&m_serverDocuments);
+
     m_help.SetInfo("Help", "Display this message");
     m_help.Init(false);
     m_help.SetKey("help");
@@ -899,6 +913,13 @@ Options::Options()
     m_allPages.SetShortOption('a', true);
     m_baseOptions.AddOption(&m_allPages);
 
+    m_batch.SetInfo("Batch manifest",
+        "Convert all the files listed in the manifest (one per line) and given as arguments into the output directory");
+    m_batch.Init("");
+    m_batch.SetKey("batch");
+    m_batch.SetShortOption('b', true);
+    m_baseOptions.AddOption(&m_batch);
+
     m_inputFrom.SetInfo("Input from",
         "Select input format from: \"abc\", \"darms\", \"humdrum\", \"mei\", \"pae\", \"xml\" (musicxml)");
     m_inputFrom.Init("mei");
@@ -906,6 +927,12 @@ Options::Options()
     m_inputFrom.SetShortOption('f', false);
     m_baseOptions.AddOption(&m_inputFrom);
 
+    m_jobs.SetInfo("Jobs", "Number of threads converting files in batch mode (default is the number of cores)");
+    m_jobs.Init(0, 0, 1024);
+    m_jobs.SetKey("jobs");
+    m_jobs.SetShortOption('j', true);
+    m_baseOptions.AddOption(&m_jobs);
+
     m_logLevel.SetInfo("Log level", "Set the log level: \"off\", \"error\", \"warning\", \"info\", or \"debug\"");
     m_logLevel.Init("warning");
     m_logLevel.SetKey("logLevel");
@@ -937,7 +964,7 @@ Options::Options()
     m_baseOptions.AddOption(&m_scale);
 
     m_outputTo.SetInfo(
-        "Output to", "Select output format to: \"mei\", \"mei-pb\", \"mei-basic\", \"svg\", or \"midi\"");
+        "Output to", "Select output format to: \"mei\", \"mei-pb\", \"mei-basic\", \"svg\", \"svgz\", or \"midi\"");
     m_outputTo.Init("svg");
     m_outputTo.SetKey("outputTo");
     m_outputTo.SetShortOption('t', true);
@@ -1032,10 +1059,20 @@ Options::Options()
     m_ligatureAsBracket.Init(false);
     this->Register(&m_ligatureAsBracket, "ligatureAsBracket", &m_general);
 
+    m_measureLayoutCheck.SetInfo("Measure layout check",
+        "Check the horizontal layout copied from identical measures against the recalculated one");
+    m_measureLayoutCheck.Init(false);
+    this->Register(&m_measureLayoutCheck, "measureLayoutCheck", &m_general);
+
     m_mensuralToMeasure.SetInfo("Mensural to measure", "Convert mensural sections to measure-based MEI");
     m_mensuralToMeasure.Init(false);
     this->Register(&m_mensuralToMeasure, "mensuralToMeasure", &m_general);
 
+    m_metricLayoutCheck.SetInfo("Metric layout check",
+        "Check the bounding boxes calculated from the glyph metrics in the horizontal layout against the drawn ones");
+    m_metricLayoutCheck.Init(false);
+    this->Register(&m_metricLayoutCheck, "metricLayoutCheck", &m_general);
+
     m_minLastJustification.SetInfo("Minimum last-system-justification width",
         "The last system is only justified if the unjustified width is greater than this percent");
     m_minLastJustification.Init(0.8, 0.0, 1.0);
@@ -1104,6 +1141,11 @@ Options::Options()
     m_pedalStyle.Init(PEDALSTYLE_NONE, &Option::s_pedalStyle);
     this->Register(&m_pedalStyle, "pedalStyle", &m_general);
 
+    m_performanceOnly.SetInfo("Performance only",
+        "Skip the layout and only calculate the timing needed for MIDI, timemap and feature output");
+    m_performanceOnly.Init(false);
+    this->Register(&m_performanceOnly, "performanceOnly", &m_general);
+
     m_preserveAnalyticalMarkup.SetInfo("Preserve analytical markup", "Preserves the analytical markup in MEI");
     m_preserveAnalyticalMarkup.Init(false);
     this->Register(&m_preserveAnalyticalMarkup, "preserveAnalyticalMarkup", &m_general);
@@ -1112,6 +1154,11 @@ Options::Options()
     m_removeIds.Init(false);
     this->Register(&m_removeIds, "removeIds", &m_general);
 
+    m_renderCacheSize.SetInfo("Render cache size",
+        "The maximum size (in bytes) of the cache of rendered SVG, MIDI, timemap and MEI output (0 to disable)");
+    m_renderCacheSize.Init(0, 0, 1024 * 1024 * 1024);
+    this->Register(&m_renderCacheSize, "renderCacheSize", &m_general);
+
     m_scaleToPageSize.SetInfo(
         "Scale to fit the page size", "Scale the content within the page instead of scaling the page itself");
     m_scaleToPageSize.Init(false);
@@ -1161,12 +1208,33 @@ Options::Options()
     m_svgRemoveXlink.Init(false);
     this->Register(&m_svgRemoveXlink, "svgRemoveXlink", &m_general);
 
+    m_svgGlyphSprite.SetInfo("Glyph sprite file for SVG",
+        "Reference the music font glyphs in the given sprite file (e.g., glyphs.svg) instead of including them in "
+        "each SVG page; the command-line tool writes the sprite next to the pages");
+    m_svgGlyphSprite.Init("");
+    this->Register(&m_svgGlyphSprite, "svgGlyphSprite", &m_general);
+
+    m_svgCompact.SetInfo("Compact SVG output",
+        "Write the SVG with raw formatting, sizes without units and fractional values without trailing zeros");
+    m_svgCompact.Init(false);
+    this->Register(&m_svgCompact, "svgCompact", &m_general);
+
+    m_svgStripIds.SetInfo("Strip ids and classes in SVG",
+        "Remove the ids and the classes not used by the styling from the SVG (for non-interactive output)");
+    m_svgStripIds.Init(false);
+    this->Register(&m_svgStripIds, "svgStripIds", &m_general);
+
     m_svgAdditionalAttribute.SetInfo("Add additional attribute in SVG",
         "Add additional attribute for graphical elements in SVG as \"data-*\", for "
         "example, \"note@pname\" would add a \"data-pname\" to all note elements");
     m_svgAdditionalAttribute.Init();
     this->Register(&m_svgAdditionalAttribute, "svgAdditionalAttribute", &m_general);
 
+    m_svgzLevel.SetInfo(
+        "SVGZ compression level", "The compression level for the SVGZ output (1 is the fastest and 9 the smallest)");
+    m_svgzLevel.Init(6, 1, 9);
+    this->Register(&m_svgzLevel, "svgzLevel", &m_general);
+
     m_unit.SetInfo("Unit", "The MEI unit (1⁄2 of the distance between the staff lines)");
     m_unit.Init(9.0, 4.5, 12.0, true);
     this->Register(&m_unit, "unit", &m_general);
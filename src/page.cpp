@@ -17,6 +17,7 @@
 #include "comparison.h"
 #include "doc.h"
 #include "functorparams.h"
+#include "measure.h"
 #include "pageelement.h"
 #include "pages.h"
 #include "pgfoot.h"
@@ -252,7 +253,7 @@ void Page::LayOutTranscription(bool force)
     m_layoutDone = true;
 }
 
-void Page::ResetAligners()
+void Page::ResetAligners(Filters *filters)
 {
     Doc *doc = vrv_cast<Doc *>(this->GetFirstAncestor(DOC));
     assert(doc);
@@ -263,11 +264,11 @@ void Page::ResetAligners()
 
     // Reset the horizontal alignment
     Functor resetHorizontalAlignment(&Object::ResetHorizontalAlignment);
-    this->Process(&resetHorizontalAlignment, NULL);
+    this->Process(&resetHorizontalAlignment, NULL, NULL, filters);
 
     // Reset the vertical alignment
     Functor resetVerticalAlignment(&Object::ResetVerticalAlignment);
-    this->Process(&resetVerticalAlignment, NULL);
+    this->Process(&resetVerticalAlignment, NULL, NULL, filters);
 
     // Align the content of the page using measure aligners
     // After this:
@@ -275,7 +276,7 @@ void Page::ResetAligners()
     Functor alignHorizontally(&Object::AlignHorizontally);
     Functor alignHorizontallyEnd(&Object::AlignHorizontallyEnd);
     AlignHorizontallyParams alignHorizontallyParams(&alignHorizontally, doc);
-    this->Process(&alignHorizontally, &alignHorizontallyParams, &alignHorizontallyEnd);
+    this->Process(&alignHorizontally, &alignHorizontallyParams, &alignHorizontallyEnd, filters);
 
     // Align the content of the page using system aligners
     // After this:
@@ -283,7 +284,7 @@ void Page::ResetAligners()
     Functor alignVertically(&Object::AlignVertically);
     Functor alignVerticallyEnd(&Object::AlignVerticallyEnd);
     AlignVerticallyParams alignVerticallyParams(doc, &alignVertically, &alignVerticallyEnd);
-    this->Process(&alignVertically, &alignVerticallyParams, &alignVerticallyEnd);
+    this->Process(&alignVertically, &alignVerticallyParams, &alignVerticallyEnd, filters);
 
     // Unless duration-based spacing is disabled, set the X position of each Alignment.
     // Does non-linear spacing based on the duration space between two Alignment objects.
@@ -306,44 +307,44 @@ void Page::ResetAligners()
         Functor setAlignmentX(&Object::CalcAlignmentXPos);
         CalcAlignmentXPosParams calcAlignmentXPosParams(doc, &setAlignmentX);
         calcAlignmentXPosParams.m_longestActualDur = longestActualDur;
-        this->Process(&setAlignmentX, &calcAlignmentXPosParams);
+        this->Process(&setAlignmentX, &calcAlignmentXPosParams, NULL, filters);
     }
 
     // Set the pitch / pos alignment
     CalcAlignmentPitchPosParams calcAlignmentPitchPosParams(doc);
     Functor calcAlignmentPitchPos(&Object::CalcAlignmentPitchPos);
-    this->Process(&calcAlignmentPitchPos, &calcAlignmentPitchPosParams);
+    this->Process(&calcAlignmentPitchPos, &calcAlignmentPitchPosParams, NULL, filters);
 
     if (Att::IsMensuralType(doc->m_notationType)) {
         FunctorDocParams calcLigatureNotePosParams(doc);
         Functor calcLigatureNotePos(&Object::CalcLigatureNotePos);
-        this->Process(&calcLigatureNotePos, &calcLigatureNotePosParams);
+        this->Process(&calcLigatureNotePos, &calcLigatureNotePosParams, NULL, filters);
     }
 
     CalcStemParams calcStemParams(doc);
     Functor calcStem(&Object::CalcStem);
-    this->Process(&calcStem, &calcStemParams);
+    this->Process(&calcStem, &calcStemParams, NULL, filters);
 
     CalcChordNoteHeadsParams calcChordNoteHeadsParams(doc);
     Functor calcChordNoteHeads(&Object::CalcChordNoteHeads);
-    this->Process(&calcChordNoteHeads, &calcChordNoteHeadsParams);
+    this->Process(&calcChordNoteHeads, &calcChordNoteHeadsParams, NULL, filters);
 
     CalcDotsParams calcDotsParams(doc);
     Functor calcDots(&Object::CalcDots);
-    this->Process(&calcDots, &calcDotsParams);
+    this->Process(&calcDots, &calcDotsParams, NULL, filters);
 
     // Adjust the position of outside articulations
     CalcArticParams calcArticParams(doc);
     Functor calcArtic(&Object::CalcArtic);
-    this->Process(&calcArtic, &calcArticParams);
+    this->Process(&calcArtic, &calcArticParams, NULL, filters);
 
     CalcSlurDirectionParams calcSlurDirectionParams(doc);
     Functor calcSlurDirection(&Object::CalcSlurDirection);
-    this->Process(&calcSlurDirection, &calcSlurDirectionParams);
+    this->Process(&calcSlurDirection, &calcSlurDirectionParams, NULL, filters);
 
     FunctorDocParams calcSpanningBeamSpansParams(doc);
     Functor calcSpanningBeamSpans(&Object::CalcSpanningBeamSpans);
-    this->Process(&calcSpanningBeamSpans, &calcSpanningBeamSpansParams);
+    this->Process(&calcSpanningBeamSpans, &calcSpanningBeamSpansParams, NULL, filters);
 }
 
 void Page::LayOutHorizontally()
@@ -371,6 +372,30 @@ void Page::LayOutHorizontally()
     Functor adjustArtic(&Object::AdjustArtic);
     this->Process(&adjustArtic, &adjustArticParams);
 
+    // Look for measures with the same content as a previous one on the page. Their horizontal layout is copied from
+    // that measure instead of being adjusted again. With --measure-layout-check it is adjusted and compared.
+    const bool checkMeasureLayout = doc->GetOptions()->m_measureLayoutCheck.GetValue();
+    std::set<const Object *> adjustedMeasures;
+    std::vector<std::pair<Measure *, const Measure *>> copiedMeasures;
+    std::map<std::vector<int>, const Measure *> measureSignatures;
+    std::vector<int> signature;
+    ListOfObjects measures = this->FindAllDescendantsByType(MEASURE, false);
+    for (Object *object : measures) {
+        Measure *measure = vrv_cast<Measure *>(object);
+        assert(measure);
+        if (measure->CalcHorizontalLayoutSignature(signature)) {
+            auto [iter, inserted] = measureSignatures.insert({ signature, measure });
+            if (!inserted) {
+                copiedMeasures.push_back({ measure, iter->second });
+                if (!checkMeasureLayout) continue;
+            }
+        }
+        adjustedMeasures.insert(measure);
+    }
+    Filters filters;
+    MeasureInSetComparison matchAdjustedMeasures(&adjustedMeasures);
+    filters.Add(&matchAdjustedMeasures);
+
     // Adjust the x position of the LayerElement where multiple layer collide
     // Look at each LayerElement and change the m_xShift if the bounding box is overlapping
     // For the first iteration align elements without taking dots into consideration
@@ -378,25 +403,25 @@ void Page::LayOutHorizontally()
     Functor adjustLayersEnd(&Object::AdjustLayersEnd);
     AdjustLayersParams adjustLayersParams(
         doc, &adjustLayers, &adjustLayersEnd, doc->GetCurrentScoreDef()->GetStaffNs());
-    this->Process(&adjustLayers, &adjustLayersParams, &adjustLayersEnd);
+    this->Process(&adjustLayers, &adjustLayersParams, &adjustLayersEnd, &filters);
 
     // Adjust dots for the multiple layers. Try to align dots that can be grouped together when layers collide,
     // otherwise keep their relative positioning
     Functor adjustDots(&Object::AdjustDots);
     Functor adjustDotsEnd(&Object::AdjustDotsEnd);
     AdjustDotsParams adjustDotsParams(doc, &adjustDots, &adjustDotsEnd, doc->GetCurrentScoreDef()->GetStaffNs());
-    this->Process(&adjustDots, &adjustDotsParams, &adjustDotsEnd);
+    this->Process(&adjustDots, &adjustDotsParams, &adjustDotsEnd, &filters);
 
     // adjust Layers again, this time including dots positioning
     AdjustLayersParams newAdjustLayersParams(
         doc, &adjustLayers, &adjustLayersEnd, doc->GetCurrentScoreDef()->GetStaffNs());
     newAdjustLayersParams.m_ignoreDots = false;
-    this->Process(&adjustLayers, &newAdjustLayersParams, &adjustLayersEnd);
+    this->Process(&adjustLayers, &newAdjustLayersParams, &adjustLayersEnd, &filters);
 
     // Adjust the X position of the accidentals, including in chords
     Functor adjustAccidX(&Object::AdjustAccidX);
     AdjustAccidXParams adjustAccidXParams(doc, &adjustAccidX);
-    this->Process(&adjustAccidX, &adjustAccidXParams);
+    this->Process(&adjustAccidX, &adjustAccidXParams, NULL, &filters);
 
     // Adjust the X shift of the Alignment looking at the bounding boxes
     // Look at each LayerElement and change the m_xShift if the bounding box is overlapping
@@ -404,7 +429,7 @@ void Page::LayOutHorizontally()
     Functor adjustXPosEnd(&Object::AdjustXPosEnd);
     AdjustXPosParams adjustXPosParams(doc, &adjustXPos, &adjustXPosEnd, doc->GetCurrentScoreDef()->GetStaffNs());
     adjustXPosParams.m_excludes.push_back(TABDURSYM);
-    this->Process(&adjustXPos, &adjustXPosParams, &adjustXPosEnd);
+    this->Process(&adjustXPos, &adjustXPosParams, &adjustXPosEnd, &filters);
 
     // Adjust tabRhyhtm separately
     adjustXPosParams.m_excludes.clear();
@@ -413,7 +438,7 @@ void Page::LayOutHorizontally()
     adjustXPosParams.m_includes.push_back(METERSIG);
     adjustXPosParams.m_includes.push_back(KEYSIG);
     adjustXPosParams.m_rightBarLinesOnly = true;
-    this->Process(&adjustXPos, &adjustXPosParams, &adjustXPosEnd);
+    this->Process(&adjustXPos, &adjustXPosParams, &adjustXPosEnd, &filters);
 
     // Adjust the X shift of the Alignment looking at the bounding boxes
     // Look at each LayerElement and change the m_xShift if the bounding box is overlapping
@@ -421,13 +446,29 @@ void Page::LayOutHorizontally()
     Functor adjustGraceXPosEnd(&Object::AdjustGraceXPosEnd);
     AdjustGraceXPosParams adjustGraceXPosParams(
         doc, &adjustGraceXPos, &adjustGraceXPosEnd, doc->GetCurrentScoreDef()->GetStaffNs());
-    this->Process(&adjustGraceXPos, &adjustGraceXPosParams, &adjustGraceXPosEnd);
+    this->Process(&adjustGraceXPos, &adjustGraceXPosParams, &adjustGraceXPosEnd, &filters);
 
     // Adjust the spacing of clef changes since they are skipped in AdjustXPos
     // Look at each clef change and  move them to the left and add space if necessary
     Functor adjustClefChanges(&Object::AdjustClefChanges);
     AdjustClefsParams adjustClefChangesParams(doc);
-    this->Process(&adjustClefChanges, &adjustClefChangesParams);
+    this->Process(&adjustClefChanges, &adjustClefChangesParams, NULL, &filters);
+
+    // Copy the horizontal layout of the identical measures
+    std::vector<int> positions, adjustedPositions;
+    for (auto [measure, source] : copiedMeasures) {
+        source->GetHorizontalLayoutPositions(positions);
+        if (checkMeasureLayout) {
+            measure->GetHorizontalLayoutPositions(adjustedPositions);
+            if (positions != adjustedPositions) {
+                LogWarning(
+                    "The horizontal layout of measure '%s' copied from measure '%s' differs from the adjusted one",
+                    measure->GetID().c_str(), source->GetID().c_str());
+            }
+            continue;
+        }
+        measure->SetHorizontalLayoutPositions(positions);
+    }
 
     // We need to populate processing lists for processing the document by Layer (for matching @tie) and
     // by Verse (for matching syllable connectors)
@@ -471,6 +512,25 @@ void Page::LayOutHorizontally()
     this->Process(&alignMeasures, &alignMeasuresParams, &alignMeasuresEnd);
 }
 
+void Page::AlignTiming()
+{
+    Doc *doc = vrv_cast<Doc *>(this->GetFirstAncestor(DOC));
+    assert(doc);
+
+    // Doc::SetDrawingPage should have been called before
+    // Make sure we have the correct page
+    assert(this == doc->GetDrawingPage());
+
+    Functor resetHorizontalAlignment(&Object::ResetHorizontalAlignment);
+    this->Process(&resetHorizontalAlignment, NULL);
+
+    // Only the time of the alignments is used - no bounding box and no positioning
+    Functor alignHorizontally(&Object::AlignHorizontally);
+    Functor alignHorizontallyEnd(&Object::AlignHorizontallyEnd);
+    AlignHorizontallyParams alignHorizontallyParams(&alignHorizontally, doc);
+    this->Process(&alignHorizontally, &alignHorizontallyParams, &alignHorizontallyEnd);
+}
+
 void Page::LayOutHorizontallyWithCache(bool restore)
 {
     Doc *doc = vrv_cast<Doc *>(this->GetFirstAncestor(DOC));
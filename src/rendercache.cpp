@@ -0,0 +1,92 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        rendercache.cpp
+// Author:      Laurent Pugin
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "rendercache.h"
+
+//----------------------------------------------------------------------------
+
+#include "vrv.h"
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// RenderCache
+//----------------------------------------------------------------------------
+
+RenderCache::RenderCache()
+{
+    m_size = 0;
+    m_maxSize = 0;
+    m_hits = 0;
+    m_misses = 0;
+    m_evictions = 0;
+}
+
+void RenderCache::SetMaxSize(size_t maxSize)
+{
+    m_maxSize = maxSize;
+    this->Evict();
+}
+
+std::string RenderCache::MakeKey(unsigned int dataChecksum, unsigned int optionsChecksum, RenderCacheType type,
+    int pageNo, const std::string &params)
+{
+    return StringFormat("%08x-%08x-%d-%d-", dataChecksum, optionsChecksum, type, pageNo) + params;
+}
+
+bool RenderCache::Get(const std::string &key, std::string &output)
+{
+    auto iter = m_index.find(key);
+    if (iter == m_index.end()) {
+        ++m_misses;
+        return false;
+    }
+    ++m_hits;
+    // Move the entry to the front of the list
+    m_entries.splice(m_entries.begin(), m_entries, iter->second);
+    output = iter->second->second;
+    return true;
+}
+
+void RenderCache::Add(const std::string &key, const std::string &output)
+{
+    const size_t entrySize = key.size() + output.size();
+    if (entrySize > m_maxSize) return;
+
+    auto iter = m_index.find(key);
+    if (iter != m_index.end()) {
+        m_size -= (iter->second->first.size() + iter->second->second.size());
+        m_entries.erase(iter->second);
+        m_index.erase(iter);
+    }
+
+    m_entries.emplace_front(key, output);
+    m_index[key] = m_entries.begin();
+    m_size += entrySize;
+
+    this->Evict();
+}
+
+void RenderCache::Clear()
+{
+    m_entries.clear();
+    m_index.clear();
+    m_size = 0;
+}
+
+void RenderCache::Evict()
+{
+    while (!m_entries.empty() && (m_size > m_maxSize)) {
+        const auto &entry = m_entries.back();
+        m_size -= (entry.first.size() + entry.second.size());
+        m_index.erase(entry.first);
+        m_entries.pop_back();
+        ++m_evictions;
+    }
+}
+
+} // namespace vrv
@@ -30,6 +30,7 @@ namespace vrv {
 thread_local std::string Resources::s_defaultPath = VRV_RESOURCE_DIR;
 const Resources::StyleAttributes Resources::k_defaultStyle{ data_FONTWEIGHT::FONTWEIGHT_normal,
     data_FONTSTYLE::FONTSTYLE_normal };
+const int Resources::k_textExtentCacheMaxEntryCount = 100000;
 
 //----------------------------------------------------------------------------
 // Function defined in toolkitdef.h
@@ -48,6 +49,9 @@ Resources::Resources()
 {
     m_path = s_defaultPath;
     m_currentStyle = k_defaultStyle;
+    m_textExtentCacheEntryCount = 0;
+    m_textExtentCacheHits = 0;
+    m_textExtentCacheMisses = 0;
 }
 
 bool Resources::InitFonts()
@@ -146,6 +150,42 @@ const Glyph *Resources::GetTextGlyph(char32_t code) const
     return &currentTable.at(code);
 }
 
+const TextExtend *Resources::GetCachedTextExtent(const std::u32string &text, int pointSize, bool typeSize) const
+{
+    auto tableIter
+        = m_textExtentCache.find({ m_currentStyle.first, m_currentStyle.second, pointSize, typeSize });
+    if (tableIter != m_textExtentCache.end()) {
+        auto iter = tableIter->second.find(text);
+        if (iter != tableIter->second.end()) {
+            ++m_textExtentCacheHits;
+            return &iter->second;
+        }
+    }
+    ++m_textExtentCacheMisses;
+    return NULL;
+}
+
+const TextExtend *Resources::CacheTextExtent(
+    const std::u32string &text, int pointSize, bool typeSize, const TextExtend &extend) const
+{
+    // Empty the cache when it is full
+    if (m_textExtentCacheEntryCount >= k_textExtentCacheMaxEntryCount) {
+        m_textExtentCache.clear();
+        m_textExtentCacheEntryCount = 0;
+    }
+
+    auto &table = m_textExtentCache[{ m_currentStyle.first, m_currentStyle.second, pointSize, typeSize }];
+    auto [iter, inserted] = table.insert({ text, extend });
+    if (inserted) ++m_textExtentCacheEntryCount;
+    return &iter->second;
+}
+
+void Resources::ResetTextExtentCache()
+{
+    m_textExtentCache.clear();
+    m_textExtentCacheEntryCount = 0;
+}
+
 char32_t Resources::GetSmuflGlyphForUnicodeChar(const char32_t unicodeChar)
 {
     char32_t smuflChar = unicodeChar;
@@ -218,6 +258,7 @@ bool Resources::LoadFont(const std::string &fontName, bool withFallback)
     }
 
     m_fontName = fontName;
+    this->ResetTextExtentCache();
     return true;
 }
 
@@ -266,6 +307,7 @@ bool Resources::InitTextFont(const std::string &fontName, const StyleAttributes
             currentTable[code] = glyph;
         }
     }
+    this->ResetTextExtentCache();
     return true;
 }
 
@@ -44,6 +44,7 @@ SvgDeviceContext::SvgDeviceContext() : DeviceContext(SVG_DEVICE_CONTEXT)
     m_smuflGlyphs.clear();
 
     m_committed = false;
+    m_outputFlags = pugi::format_default;
     m_vrvTextFont = false;
     m_vrvTextFontFallback = false;
 
@@ -53,6 +54,8 @@ SvgDeviceContext::SvgDeviceContext() : DeviceContext(SVG_DEVICE_CONTEXT)
     m_html5 = false;
     m_formatRaw = false;
     m_removeXlink = false;
+    m_compact = false;
+    m_stripIds = false;
     m_facsimile = false;
     m_indent = 2;
 
@@ -164,39 +167,29 @@ void SvgDeviceContext::Commit(bool xml_declaration)
         }
     }
 
-    // header
-    if (m_smuflGlyphs.size() > 0) {
+    // header - the glyphs are in the sprite file when referenced externally
+    if ((m_smuflGlyphs.size() > 0) && m_glyphSprite.empty()) {
 
         pugi::xml_node defs = m_svgNode.prepend_child("defs");
-        pugi::xml_document sourceDoc;
 
         // for each needed glyph
         for (auto it = m_smuflGlyphs.begin(); it != m_smuflGlyphs.end(); ++it) {
-            // load the XML file that contains it as a pugi::xml_document
-            std::ifstream source((*it)->GetPath());
-            sourceDoc.load(source);
-
-            // copy all the nodes inside into the master document
-            for (pugi::xml_node child = sourceDoc.first_child(); child; child = child.next_sibling()) {
-                std::string id = StringFormat("%s-%s", child.attribute("id").value(), m_glyphPostfixId.c_str());
-                child.attribute("id").set_value(id.c_str());
-                defs.append_copy(child);
-            }
+            AppendGlyphSymbol(defs, *it, m_glyphPostfixId);
         }
     }
 
-    unsigned int output_flags = pugi::format_default | pugi::format_no_declaration;
+    m_outputFlags = pugi::format_default | pugi::format_no_declaration;
     if (xml_declaration) {
         // edit the xml declaration
-        output_flags = pugi::format_default;
+        m_outputFlags = pugi::format_default;
         pugi::xml_node decl = m_svgDoc.prepend_child(pugi::node_declaration);
         decl.append_attribute("version") = "1.0";
         decl.append_attribute("encoding") = "UTF-8";
         decl.append_attribute("standalone") = "no";
     }
 
-    if (m_formatRaw) {
-        output_flags |= pugi::format_raw;
+    if (m_formatRaw || m_compact) {
+        m_outputFlags |= pugi::format_raw;
     }
 
     // add description statement
@@ -204,13 +197,67 @@ void SvgDeviceContext::Commit(bool xml_declaration)
     desc.append_child(pugi::node_pcdata)
         .set_value(StringFormat("Engraved by Verovio %s", GetVersion().c_str()).c_str());
 
-    // save the glyph data to m_outdata
-    std::string indent = (m_indent == -1) ? "\t" : std::string(m_indent, ' ');
-    m_svgDoc.save(m_outdata, indent.c_str(), output_flags);
-
     m_committed = true;
 }
 
+void SvgDeviceContext::AppendGlyphSymbol(pugi::xml_node defs, const Glyph *glyph, const std::string &postfixId)
+{
+    assert(glyph);
+
+    // load the XML file that contains it as a pugi::xml_document
+    pugi::xml_document sourceDoc;
+    std::ifstream source(glyph->GetPath());
+    sourceDoc.load(source);
+
+    // copy all the nodes inside into the master document
+    for (pugi::xml_node child = sourceDoc.first_child(); child; child = child.next_sibling()) {
+        if (!postfixId.empty()) {
+            std::string id = StringFormat("%s-%s", child.attribute("id").value(), postfixId.c_str());
+            child.attribute("id").set_value(id.c_str());
+        }
+        defs.append_copy(child);
+    }
+}
+
+std::string SvgDeviceContext::GetGlyphSpriteSVG(const std::vector<const Glyph *> &glyphs, int indent, bool formatRaw)
+{
+    pugi::xml_document spriteDoc;
+    pugi::xml_node decl = spriteDoc.append_child(pugi::node_declaration);
+    decl.append_attribute("version") = "1.0";
+    decl.append_attribute("encoding") = "UTF-8";
+    decl.append_attribute("standalone") = "no";
+
+    pugi::xml_node svgNode = spriteDoc.append_child("svg");
+    svgNode.append_attribute("version") = "1.1";
+    svgNode.append_attribute("xmlns") = "http://www.w3.org/2000/svg";
+    svgNode.append_attribute("xmlns:xlink") = "http://www.w3.org/1999/xlink";
+    svgNode.append_child("desc").append_child(pugi::node_pcdata).set_value(
+        StringFormat("Glyphs engraved by Verovio %s", GetVersion().c_str()).c_str());
+
+    pugi::xml_node defs = svgNode.append_child("defs");
+    for (const Glyph *glyph : glyphs) {
+        AppendGlyphSymbol(defs, glyph, "");
+    }
+
+    unsigned int outputFlags = pugi::format_default;
+    if (formatRaw) outputFlags |= pugi::format_raw;
+    std::string indentStr = (indent == -1) ? "\t" : std::string(indent, ' ');
+    std::ostringstream output;
+    spriteDoc.save(output, indentStr.c_str(), outputFlags);
+    return output.str();
+}
+
+std::string SvgDeviceContext::FormatDouble(double value) const
+{
+    std::string str = StringFormat("%f", value);
+    if (!m_compact) return str;
+
+    str.erase(str.find_last_not_of('0') + 1);
+    if (str.back() == '.') str.pop_back();
+    if (str == "-0") str = "0";
+    return str;
+}
+
 void SvgDeviceContext::StartGraphic(
     Object *object, std::string gClass, std::string gId, GraphicID graphicID, bool prepend)
 {
@@ -429,7 +476,8 @@ void SvgDeviceContext::RotateGraphic(Point const &orig, double angle)
         return;
     }
 
-    m_currentNode.append_attribute("transform") = StringFormat("rotate(%f %d,%d)", angle, orig.x, orig.y).c_str();
+    m_currentNode.append_attribute("transform")
+        = StringFormat("rotate(%s %d,%d)", this->FormatDouble(angle).c_str(), orig.x, orig.y).c_str();
 }
 
 void SvgDeviceContext::StartPage()
@@ -756,7 +804,7 @@ void SvgDeviceContext::DrawPolyline(int n, Point points[], int xOffset, int yOff
         polylineChild.append_attribute("stroke-width") = StringFormat("%d", currentPen.GetWidth()).c_str();
     }
     if (currentPen.GetOpacity() != 1.0) {
-        polylineChild.append_attribute("stroke-opacity") = StringFormat("%f", currentPen.GetOpacity()).c_str();
+        polylineChild.append_attribute("stroke-opacity") = this->FormatDouble(currentPen.GetOpacity()).c_str();
     }
 
     this->AppendStrokeLineCap(polylineChild, currentPen);
@@ -789,7 +837,7 @@ void SvgDeviceContext::DrawPolygon(int n, Point points[], int xOffset, int yOffs
         polygonChild.append_attribute("stroke-width") = StringFormat("%d", currentPen.GetWidth()).c_str();
     }
     if (currentPen.GetOpacity() != 1.0) {
-        polygonChild.append_attribute("stroke-opacity") = StringFormat("%f", currentPen.GetOpacity()).c_str();
+        polygonChild.append_attribute("stroke-opacity") = this->FormatDouble(currentPen.GetOpacity()).c_str();
     }
 
     this->AppendStrokeLineJoin(polygonChild, currentPen);
@@ -798,7 +846,7 @@ void SvgDeviceContext::DrawPolygon(int n, Point points[], int xOffset, int yOffs
     if (currentBrush.GetColour() != AxNONE)
         polygonChild.append_attribute("fill") = this->GetColour(currentBrush.GetColour()).c_str();
     if (currentBrush.GetOpacity() != 1.0)
-        polygonChild.append_attribute("fill-opacity") = StringFormat("%f", currentBrush.GetOpacity()).c_str();
+        polygonChild.append_attribute("fill-opacity") = this->FormatDouble(currentBrush.GetOpacity()).c_str();
 
     std::string pointsString = StringFormat("%d,%d", points[0].x + xOffset, points[0].y + yOffset);
     for (int i = 1; i < n; ++i) {
@@ -823,7 +871,7 @@ void SvgDeviceContext::DrawRoundedRectangle(int x, int y, int width, int height,
         if (currentPen.GetWidth() > 1)
             rectChild.append_attribute("stroke-width") = StringFormat("%d", currentPen.GetWidth()).c_str();
         if (currentPen.GetOpacity() != 1.0)
-            rectChild.append_attribute("stroke-opacity") = StringFormat("%f", currentPen.GetOpacity()).c_str();
+            rectChild.append_attribute("stroke-opacity") = this->FormatDouble(currentPen.GetOpacity()).c_str();
     }
 
     if (m_brushStack.size()) {
@@ -831,7 +879,7 @@ void SvgDeviceContext::DrawRoundedRectangle(int x, int y, int width, int height,
         if (currentBrush.GetColour() != AxNONE)
             rectChild.append_attribute("fill") = this->GetColour(currentBrush.GetColour()).c_str();
         if (currentBrush.GetOpacity() != 1.0)
-            rectChild.append_attribute("fill-opacity") = StringFormat("%f", currentBrush.GetOpacity()).c_str();
+            rectChild.append_attribute("fill-opacity") = this->FormatDouble(currentBrush.GetOpacity()).c_str();
     }
 
     // negative heights or widths are not allowed in SVG
@@ -875,7 +923,7 @@ void SvgDeviceContext::StartText(int x, int y, data_HORIZONTALALIGNMENT alignmen
     }
     // font-size seems to be required in <text> in FireFox and also we set it to 0px so space
     // is not added between tspan elements
-    m_currentNode.append_attribute("font-size") = "0px";
+    m_currentNode.append_attribute("font-size") = (m_compact) ? "0" : "0px";
     //
     if (!m_fontStack.top()->GetFaceName().empty()) {
         m_currentNode.append_attribute("font-family") = m_fontStack.top()->GetFaceName().c_str();
@@ -968,7 +1016,8 @@ void SvgDeviceContext::DrawText(
         }
     }
     if (m_fontStack.top()->GetPointSize() != 0) {
-        textChild.append_attribute("font-size") = StringFormat("%dpx", m_fontStack.top()->GetPointSize()).c_str();
+        textChild.append_attribute("font-size")
+            = StringFormat((m_compact) ? "%d" : "%dpx", m_fontStack.top()->GetPointSize()).c_str();
     }
     if (m_fontStack.top()->GetStyle() != FONTSTYLE_NONE) {
         if (m_fontStack.top()->GetStyle() == FONTSTYLE_italic) {
@@ -1034,16 +1083,29 @@ void SvgDeviceContext::DrawMusicText(const std::u32string &text, int x, int y, b
 
         // Write the char in the SVG
         pugi::xml_node useChild = AppendChild("use");
-        useChild.append_attribute(hrefAttrib.c_str())
-            = StringFormat("#%s-%s", glyph->GetCodeStr().c_str(), m_glyphPostfixId.c_str()).c_str();
+        if (m_glyphSprite.empty()) {
+            useChild.append_attribute(hrefAttrib.c_str())
+                = StringFormat("#%s-%s", glyph->GetCodeStr().c_str(), m_glyphPostfixId.c_str()).c_str();
+        }
+        else {
+            useChild.append_attribute(hrefAttrib.c_str())
+                = StringFormat("%s#%s", m_glyphSprite.c_str(), glyph->GetCodeStr().c_str()).c_str();
+        }
         useChild.append_attribute("x") = x;
         useChild.append_attribute("y") = y;
-        useChild.append_attribute("height") = StringFormat("%dpx", m_fontStack.top()->GetPointSize()).c_str();
-        useChild.append_attribute("width") = StringFormat("%dpx", m_fontStack.top()->GetPointSize()).c_str();
+        if (m_compact) {
+            useChild.append_attribute("height") = m_fontStack.top()->GetPointSize();
+            useChild.append_attribute("width") = m_fontStack.top()->GetPointSize();
+        }
+        else {
+            useChild.append_attribute("height") = StringFormat("%dpx", m_fontStack.top()->GetPointSize()).c_str();
+            useChild.append_attribute("width") = StringFormat("%dpx", m_fontStack.top()->GetPointSize()).c_str();
+        }
         if (m_fontStack.top()->GetWidthToHeightRatio() != 1.0f) {
-            useChild.append_attribute("transform") = StringFormat("matrix(%f,0,0,1,%f,0)",
-                m_fontStack.top()->GetWidthToHeightRatio(), x * (1. - m_fontStack.top()->GetWidthToHeightRatio()))
-                                                         .c_str();
+            const double ratio = m_fontStack.top()->GetWidthToHeightRatio();
+            const std::string transform = StringFormat(
+                "matrix(%s,0,0,1,%s,0)", this->FormatDouble(ratio).c_str(), this->FormatDouble(x * (1. - ratio)).c_str());
+            useChild.append_attribute("transform") = transform.c_str();
         }
 
         // Get the bounds of the char
@@ -1071,7 +1133,8 @@ void SvgDeviceContext::DrawGraphicUri(int x, int y, int width, int height, const
 void SvgDeviceContext::DrawSvgShape(int x, int y, int width, int height, double scale, pugi::xml_node svg)
 {
     m_currentNode.append_attribute("transform")
-        = StringFormat("translate(%d, %d) scale(%f, %f)", x, y, scale * DEFINITION_FACTOR, scale * DEFINITION_FACTOR)
+        = StringFormat("translate(%d, %d) scale(%s, %s)", x, y, this->FormatDouble(scale * DEFINITION_FACTOR).c_str(),
+            this->FormatDouble(scale * DEFINITION_FACTOR).c_str())
               .c_str();
 
     // Remove the ID in the SVG because it might be duplicated and that will not be valid
@@ -1095,6 +1158,20 @@ void SvgDeviceContext::AppendIdAndClass(
 {
     std::transform(baseClass.begin(), baseClass.begin() + 1, baseClass.begin(), ::tolower);
 
+    if (m_stripIds) {
+        // Keep only the classes used by the default styling of StartPage, or all of them with an additional CSS
+        static const std::set<std::string> styledClasses
+            = { "ending", "fing", "reh", "tempo", "dir", "dynam", "mNum", "label" };
+        if (!m_css.empty()) {
+            if (!addedClasses.empty()) baseClass.append(" " + addedClasses);
+            m_currentNode.append_attribute("class") = baseClass.c_str();
+        }
+        else if (styledClasses.count(baseClass)) {
+            m_currentNode.append_attribute("class") = baseClass.c_str();
+        }
+        return;
+    }
+
     if (gId.length() > 0) {
         if (m_html5) {
             m_currentNode.append_attribute("data-id") = gId.c_str();
@@ -1161,11 +1238,23 @@ std::string SvgDeviceContext::GetColour(int colour)
 
 std::string SvgDeviceContext::GetStringSVG(bool xml_declaration)
 {
-    if (!m_committed) Commit(xml_declaration);
+    // save the svg data to m_outdata only once
+    if (m_outdata.tellp() <= 0) {
+        pugi::xml_writer_stream writer(m_outdata);
+        this->WriteSVG(writer, xml_declaration);
+    }
 
     return m_outdata.str();
 }
 
+void SvgDeviceContext::WriteSVG(pugi::xml_writer &writer, bool xml_declaration)
+{
+    if (!m_committed) Commit(xml_declaration);
+
+    std::string indent = (m_indent == -1) ? "\t" : std::string(m_indent, ' ');
+    m_svgDoc.save(writer, indent.c_str(), m_outputFlags);
+}
+
 void SvgDeviceContext::DrawSvgBoundingBoxRectangle(int x, int y, int width, int height)
 {
     std::string s;
@@ -10,6 +10,7 @@
 //----------------------------------------------------------------------------
 
 #include <cassert>
+#include <deque>
 
 //----------------------------------------------------------------------------
 
@@ -481,6 +482,103 @@ void System::ConvertToUnCastOffMensuralSystem()
     }
 }
 
+std::set<const Measure *> System::CalcOptimalBreaks(const Doc *doc, int systemWidth, int scoreDefWidth)
+{
+    assert(doc);
+
+    std::set<const Measure *> breakMeasures;
+
+    // The measures with the left and right positions of a system starting and ending with them
+    // The left position includes the width of the scoreDef at the beginning of the system
+    std::vector<const Measure *> measures;
+    std::vector<int> lefts;
+    std::vector<int> rights;
+    // Whether a system can start with the measure
+    std::vector<bool> canStart;
+    const int overflowLimit = doc->GetDrawingUnit(100) * 5;
+    bool isPending = false;
+    for (Object *child : this->GetChildren()) {
+        if (child->Is(SCOREDEF)) {
+            ScoreDef *scoreDef = vrv_cast<ScoreDef *>(child);
+            assert(scoreDef);
+            // See ScoreDef::CastOffSystems
+            scoreDefWidth = scoreDef->GetDrawingWidth() + this->GetDrawingAbbrLabelsWidth();
+        }
+        else if (child->Is(MEASURE)) {
+            Measure *measure = vrv_cast<Measure *>(child);
+            assert(measure);
+            const int left = (measures.empty()) ? -this->GetDrawingLabelsWidth() : measure->GetDrawingXRel();
+            lefts.push_back(left - scoreDefWidth);
+            rights.push_back(measure->GetDrawingXRel() + measure->GetCastOffWidth());
+            // A measure following a measure with overflowing content cannot start a system because the latter is kept
+            // with it (see Measure::CastOffSystems)
+            canStart.push_back(!measures.empty() && !isPending);
+            isPending = (!measures.empty() && (measure->GetCastOffOverflow() > overflowLimit));
+            measures.push_back(measure);
+        }
+    }
+
+    const int count = (int)measures.size();
+    if ((count < 2) || (systemWidth <= 0)) return breakMeasures;
+
+    // The demerits of a system with the measures from start to end (excluded) when justified.
+    // The badness is the cube of the stretching ratio as in the Knuth-Plass algorithm, and overfull systems are
+    // penalized linearly with a large factor. This keeps the demerits convex in the width of the content, which
+    // makes them satisfy the quadrangle inequality. The last system is not exempted so the systems are balanced.
+    // A last system with a single measure is therefore unlikely, but it is not excluded here: as with the other
+    // breaks, --breaks-no-widow moves it into the previous system only if it would start a new page, which is not
+    // known at this stage (see Measure::CastOffSystems and System::CastOffPages).
+    auto getDemerits = [&](int start, int end) {
+        const double ratio = double(systemWidth - rights.at(end - 1) + lefts.at(start)) / systemWidth;
+        if (ratio < 0.0) return 1.0 - ratio * 1.0e8;
+        const double badness = 1.0 + 100.0 * ratio * ratio * ratio;
+        return badness * badness;
+    };
+
+    // The minimal demerits of the systems before each measure and the start of the system ending there
+    std::vector<double> totals(count + 1, 0.0);
+    std::vector<int> previous(count + 1, 0);
+    auto isBetter = [&](int start, int other, int end) {
+        return (totals.at(start) + getDemerits(start, end) <= totals.at(other) + getDemerits(other, end));
+    };
+
+    // Because of the quadrangle inequality, the best start of a system is monotone in its end.
+    // The candidate starts are kept in a queue with the first end from which each one is the best, and a new
+    // candidate is placed by binary search, which makes the search O(n log n) instead of O(n^2).
+    std::deque<std::pair<int, int>> candidates = { { 0, 1 } };
+    for (int end = 1; end <= count; ++end) {
+        while ((candidates.size() > 1) && (candidates.at(1).second <= end)) candidates.pop_front();
+        const int start = candidates.front().first;
+        totals.at(end) = totals.at(start) + getDemerits(start, end);
+        previous.at(end) = start;
+
+        if ((end == count) || !canStart.at(end)) continue;
+        // Remove the candidates that are beaten by the new one from their first end onwards
+        while ((candidates.back().second > end)
+            && isBetter(end, candidates.back().first, candidates.back().second)) {
+            candidates.pop_back();
+        }
+        int low = std::max(candidates.back().second, end + 1);
+        int high = count + 1;
+        while (low < high) {
+            const int middle = (low + high) / 2;
+            if (isBetter(end, candidates.back().first, middle)) {
+                high = middle;
+            }
+            else {
+                low = middle + 1;
+            }
+        }
+        if (low <= count) candidates.push_back({ end, low });
+    }
+
+    for (int start = previous.at(count); start > 0; start = previous.at(start)) {
+        breakMeasures.insert(measures.at(start));
+    }
+
+    return breakMeasures;
+}
+
 //----------------------------------------------------------------------------
 // System functor methods
 //----------------------------------------------------------------------------
@@ -1179,6 +1277,11 @@ int System::CastOffSystems(FunctorParams *functorParams)
     params->m_currentScoreDefWidth
         = params->m_page->m_drawingScoreDef.GetDrawingWidth() + this->GetDrawingAbbrLabelsWidth();
 
+    if (params->m_optimal) {
+        params->m_breakMeasures
+            = this->CalcOptimalBreaks(params->m_doc, params->m_systemWidth, params->m_currentScoreDefWidth);
+    }
+
     return FUNCTOR_CONTINUE;
 }
 
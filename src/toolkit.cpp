@@ -9,18 +9,23 @@
 
 //----------------------------------------------------------------------------
 
+#include <atomic>
 #include <cassert>
+#include <cmath>
 #include <codecvt>
 #include <locale>
 #include <regex>
+#include <thread>
 
 //----------------------------------------------------------------------------
 
 #include "comparison.h"
 #include "custos.h"
+#include "displaylistdevicecontext.h"
 #include "editortoolkit_cmn.h"
 #include "editortoolkit_mensural.h"
 #include "editortoolkit_neume.h"
+#include "featureextractor.h"
 #include "functorparams.h"
 #include "ioabc.h"
 #include "iodarms.h"
@@ -28,7 +33,9 @@
 #include "iomei.h"
 #include "iomusxml.h"
 #include "iopae.h"
+#include "iosnapshot.h"
 #include "layer.h"
+#include "mappedfile.h"
 #include "measure.h"
 #include "nc.h"
 #include "neume.h"
@@ -58,6 +65,66 @@ const char *UTF_16_BE_BOM = "\xFE\xFF";
 const char *UTF_16_LE_BOM = "\xFF\xFE";
 const char *ZIP_SIGNATURE = "\x50\x4B\x03\x04";
 
+#ifndef NO_MXL_SUPPORT
+
+//----------------------------------------------------------------------------
+// SvgzWriter
+//----------------------------------------------------------------------------
+
+/**
+ * A pugi::xml_writer deflating the chunks of SVG written by pugixml into a gzip stream.
+ */
+class SvgzWriter : public pugi::xml_writer {
+public:
+    SvgzWriter(std::ostream &stream, int level) : m_stream(stream), m_compressor(new tdefl_compressor)
+    {
+        // The gzip header without file name and modification time
+        const char header[10] = { '\x1f', '\x8b', 8, 0, 0, 0, 0, 0, 0, '\xff' };
+        m_stream.write(header, sizeof(header));
+        // Negative window bits for a raw deflate stream (without the zlib header)
+        const mz_uint flags
+            = tdefl_create_comp_flags_from_zip_params(level, -MZ_DEFAULT_WINDOW_BITS, MZ_DEFAULT_STRATEGY);
+        m_ok = (tdefl_init(m_compressor.get(), SvgzWriter::PutBuffer, &m_stream, flags) == TDEFL_STATUS_OKAY);
+    }
+
+    void write(const void *data, size_t size) override
+    {
+        if (!m_ok) return;
+        m_crc = mz_crc32(m_crc, static_cast<const mz_uint8 *>(data), size);
+        m_size += size;
+        m_ok = (tdefl_compress_buffer(m_compressor.get(), data, size, TDEFL_NO_FLUSH) == TDEFL_STATUS_OKAY);
+    }
+
+    bool Finish()
+    {
+        if (m_ok) m_ok = (tdefl_compress_buffer(m_compressor.get(), NULL, 0, TDEFL_FINISH) == TDEFL_STATUS_DONE);
+        // The gzip trailer with the CRC-32 and the input size (modulo 2^32) in little-endian
+        char trailer[8];
+        for (int i = 0; i < 4; ++i) {
+            trailer[i] = (char)((m_crc >> (8 * i)) & 0xFF);
+            trailer[i + 4] = (char)((m_size >> (8 * i)) & 0xFF);
+        }
+        m_stream.write(trailer, sizeof(trailer));
+        return (m_ok && m_stream.good());
+    }
+
+private:
+    static mz_bool PutBuffer(const void *buffer, int length, void *user)
+    {
+        std::ostream *stream = static_cast<std::ostream *>(user);
+        stream->write(static_cast<const char *>(buffer), length);
+        return stream->good();
+    }
+
+    std::ostream &m_stream;
+    std::unique_ptr<tdefl_compressor> m_compressor;
+    mz_ulong m_crc = MZ_CRC32_INIT;
+    size_t m_size = 0;
+    bool m_ok;
+};
+
+#endif /* NO_MXL_SUPPORT */
+
 //----------------------------------------------------------------------------
 // Toolkit
 //----------------------------------------------------------------------------
@@ -80,6 +147,12 @@ Toolkit::Toolkit(bool initFont)
     m_options = m_doc.GetOptions();
 
     m_skipLayoutOnLoad = false;
+    m_resetsLogBuffer = true;
+
+    m_dataChecksum = 0;
+    m_renderCacheGeneration = m_doc.GetStructureGeneration();
+    m_displayListsChecksum = 0;
+    m_displayListsGeneration = m_doc.GetStructureGeneration();
 
     m_editorToolkit = NULL;
 
@@ -166,7 +239,13 @@ bool Toolkit::SetOutputTo(std::string const &outputTo)
     else if (outputTo == "pae") {
         m_outputTo = PAE;
     }
-    else if (outputTo != "svg") {
+    else if (outputTo == "feature-index") {
+        m_outputTo = FEATUREINDEX;
+    }
+    else if (outputTo == "snapshot") {
+        m_outputTo = SNAPSHOT;
+    }
+    else if ((outputTo != "svg") && (outputTo != "svgz")) {
         LogError("Output format '%s' is not supported", outputTo.c_str());
         return false;
     }
@@ -211,6 +290,9 @@ bool Toolkit::SetInputFrom(std::string const &inputFrom)
     else if (inputFrom == "esac") {
         m_inputFrom = ESAC;
     }
+    else if (inputFrom == "snapshot") {
+        m_inputFrom = SNAPSHOT;
+    }
     else if (inputFrom == "auto") {
         m_inputFrom = AUTO;
     }
@@ -221,7 +303,7 @@ bool Toolkit::SetInputFrom(std::string const &inputFrom)
     return true;
 }
 
-FileFormat Toolkit::IdentifyInputFrom(const std::string &data)
+FileFormat Toolkit::IdentifyInputFrom(std::string_view data)
 {
 #ifdef MUSICXML_DEFAULT_HUMDRUM
     FileFormat musicxmlDefault = MUSICXMLHUM;
@@ -232,12 +314,15 @@ FileFormat Toolkit::IdentifyInputFrom(const std::string &data)
     if (data.empty()) {
         return UNKNOWN;
     }
+    if (SnapshotInput::IsSnapshot(data)) {
+        return SNAPSHOT;
+    }
     if (data[0] == 0) {
         return UNKNOWN;
     }
-    std::string excerpt = data.substr(0, 2000);
-    std::string::size_type found = excerpt.find("Group memberships:");
-    if (found != std::string::npos) {
+    std::string_view excerpt = data.substr(0, 2000);
+    std::string_view::size_type found = excerpt.find("Group memberships:");
+    if (found != std::string_view::npos) {
         // MuseData may contain '@' as first character, so needs
         // to be checked before PAE identification.
         return MUSEDATAHUM;
@@ -260,7 +345,7 @@ FileFormat Toolkit::IdentifyInputFrom(const std::string &data)
         return UNKNOWN;
     }
     size_t searchLimit = 600;
-    std::string initial = data.substr(0, searchLimit);
+    std::string_view initial = data.substr(0, searchLimit);
     if (data[0] == '<') {
         // <mei> == root node for standard organization of MEI data
         // <pages> == root node for pages organization of MEI data
@@ -268,19 +353,20 @@ FileFormat Toolkit::IdentifyInputFrom(const std::string &data)
         // <score-timewise> == root node for time-wise organization of MusicXML data
         // <opus> == root node for multi-movement/work organization of MusicXML data
 
-        if (std::regex_search(initial, std::regex("<(mei|music|pages)[\\s\\n>]"))) {
+        if (std::regex_search(initial.begin(), initial.end(), std::regex("<(mei|music|pages)[\\s\\n>]"))) {
             return MEI;
         }
-        if (std::regex_search(initial, std::regex("<(!DOCTYPE )?(score-partwise|opus|score-timewise)[\\s\\n>]"))) {
+        if (std::regex_search(initial.begin(), initial.end(),
+                std::regex("<(!DOCTYPE )?(score-partwise|opus|score-timewise)[\\s\\n>]"))) {
             return musicxmlDefault;
         }
         LogWarning("Warning: Trying to load unknown XML data which cannot be identified.");
         return UNKNOWN;
     }
-    if (initial.find("\n!!") != std::string::npos) {
+    if (initial.find("\n!!") != std::string_view::npos) {
         return HUMDRUM;
     }
-    if (initial.find("\n**") != std::string::npos) {
+    if (initial.find("\n**") != std::string_view::npos) {
         return HUMDRUM;
     }
 
@@ -291,70 +377,44 @@ FileFormat Toolkit::IdentifyInputFrom(const std::string &data)
 
 bool Toolkit::LoadFile(const std::string &filename)
 {
-    if (this->IsUTF16(filename)) {
-        return this->LoadUTF16File(filename);
-    }
-    if (this->IsZip(filename)) {
-        return this->LoadZipFile(filename);
-    }
-
-    std::ifstream in(filename.c_str());
-    if (!in.is_open()) {
+    // Map the file once - the BOM and the zip signature are checked on the mapped bytes
+    MappedFile file;
+    if (!file.Open(filename)) {
         return false;
     }
 
-    in.seekg(0, std::ios::end);
-    std::streamsize fileSize = (std::streamsize)in.tellg();
-    in.clear();
-    in.seekg(0, std::ios::beg);
-
-    // read the file into the std::string:
-    std::string content(fileSize, 0);
-    in.read(&content[0], fileSize);
+    if (this->IsUTF16(file.GetView())) {
+        return this->LoadUTF16Data(file.GetView());
+    }
+    if (this->IsZip(file.GetView())) {
+        return this->LoadZipData(file.GetView());
+    }
 
     m_doc.m_expansionMap.Reset();
 
-    return this->LoadData(content);
+    // The mapping is private and can be parsed in place
+    return this->LoadBuffer(file.GetView(), true);
 }
 
-bool Toolkit::IsUTF16(const std::string &filename)
+bool Toolkit::IsUTF16(std::string_view data)
 {
-    std::ifstream fin(filename.c_str(), std::ios::in | std::ios::binary);
-    if (!fin.is_open()) {
-        return false;
-    }
-
-    char data[2];
-    memset(data, 0, 2);
-    fin.read(data, 2);
-    fin.close();
+    if (data.size() < 2) return false;
 
-    if (memcmp(data, UTF_16_LE_BOM, 2) == 0) return true;
-    if (memcmp(data, UTF_16_BE_BOM, 2) == 0) return true;
+    if (memcmp(data.data(), UTF_16_LE_BOM, 2) == 0) return true;
+    if (memcmp(data.data(), UTF_16_BE_BOM, 2) == 0) return true;
 
     return false;
 }
 
-bool Toolkit::LoadUTF16File(const std::string &filename)
+bool Toolkit::LoadUTF16Data(std::string_view data)
 {
     /// Loading a UTF-16 file with basic conversion ot UTF-8
     /// This is called after checking if the file has a UTF-16 BOM
 
     LogWarning("The file seems to be UTF-16 - trying to convert to UTF-8");
 
-    std::ifstream fin(filename.c_str(), std::ios::in | std::ios::binary);
-    if (!fin.is_open()) {
-        return false;
-    }
-
-    fin.seekg(0, std::ios::end);
-    std::streamsize wfileSize = (std::streamsize)fin.tellg();
-    fin.clear();
-    // Skip the BOM
-    fin.seekg(0, std::wios::beg);
-
-    std::u16string u16data((wfileSize / 2) + 1, '\0');
-    fin.read((char *)&u16data[0], wfileSize);
+    std::u16string u16data((data.size() / 2) + 1, '\0');
+    memcpy(&u16data[0], data.data(), data.size());
 
     // order of the bytes has to be flipped
     if (u16data.at(0) == u'\uFFFE') {
@@ -373,74 +433,60 @@ bool Toolkit::LoadUTF16File(const std::string &filename)
     return this->LoadData(utf8line);
 }
 
-bool Toolkit::IsZip(const std::string &filename)
+bool Toolkit::IsZip(std::string_view data)
 {
-    std::ifstream fin(filename.c_str(), std::ios::in | std::ios::binary);
-    if (!fin.is_open()) {
-        return false;
-    }
-
-    char data[4];
-    memset(data, 0, 4);
-    fin.read(data, 4);
-    fin.close();
+    if (data.size() < 4) return false;
 
-    if (memcmp(data, ZIP_SIGNATURE, 4) == 0) return true;
+    if (memcmp(data.data(), ZIP_SIGNATURE, 4) == 0) return true;
 
     return false;
 }
 
-bool Toolkit::LoadZipFile(const std::string &filename)
+bool Toolkit::LoadZipData(std::string_view data)
 {
-    std::ifstream fin(filename.c_str(), std::ios::in | std::ios::binary);
-    if (!fin.is_open()) {
+#ifndef NO_MXL_SUPPORT
+    // The archive is read directly from the buffer without copying it
+    mz_zip_archive archive;
+    mz_zip_zero_struct(&archive);
+    if (!mz_zip_reader_init_mem(&archive, data.data(), data.size(), 0)) {
+        LogError("The archive could not be read");
         return false;
     }
 
-    fin.seekg(0, std::ios::end);
-    std::streamsize fileSize = (std::streamsize)fin.tellg();
-    fin.clear();
-    fin.seekg(0, std::wios::beg);
-
-    std::vector<unsigned char> bytes;
-    bytes.reserve(fileSize + 1);
-
-    unsigned char buffer;
-    while (fin.read((char *)&buffer, sizeof(unsigned char))) {
-        bytes.push_back(buffer);
-    }
-
-    return this->LoadZipData(bytes);
-}
-
-bool Toolkit::LoadZipData(const std::vector<unsigned char> &bytes)
-{
-#ifndef NO_MXL_SUPPORT
-    miniz_cpp::zip_file file(bytes);
-
     std::string filename;
-    // Look for the meta file in the zip
-    for (auto &member : file.infolist()) {
-        if (member.filename == "META-INF/container.xml") {
-            std::string container = file.read(member.filename);
-            // Find the file name with an xpath query
+    // Look for the meta file in the central directory of the zip
+    int containerIndex = mz_zip_reader_locate_file(&archive, "META-INF/container.xml", NULL, 0);
+    if (containerIndex >= 0) {
+        size_t containerSize = 0;
+        void *container = mz_zip_reader_extract_to_heap(&archive, containerIndex, &containerSize, 0);
+        if (container) {
             pugi::xml_document doc;
-            doc.load_buffer(container.c_str(), container.size());
-            pugi::xml_node root = doc.first_child();
-            pugi::xml_node rootfile = root.select_node("/container/rootfiles/rootfile").node();
+            doc.load_buffer(container, containerSize);
+            pugi::xml_node rootfile = doc.child("container").child("rootfiles").child("rootfile");
             filename = rootfile.attribute("full-path").value();
-            break;
+            mz_free(container);
         }
     }
 
-    if (!filename.empty()) {
-        LogInfo("Loading file '%s' in the archive", filename.c_str());
-        return this->LoadData(file.read(filename));
-    }
-    else {
+    int fileIndex = (filename.empty()) ? -1 : mz_zip_reader_locate_file(&archive, filename.c_str(), NULL, 0);
+    mz_zip_archive_file_stat fileStat;
+    if ((fileIndex < 0) || !mz_zip_reader_file_stat(&archive, fileIndex, &fileStat)) {
+        mz_zip_reader_end(&archive);
         LogError("No file to load found in the archive");
         return false;
     }
+
+    LogInfo("Loading file '%s' in the archive", filename.c_str());
+    // Inflate the file directly into the buffer that is then parsed in place
+    std::string buffer((size_t)fileStat.m_uncomp_size, '\0');
+    bool extracted = mz_zip_reader_extract_to_mem(&archive, fileIndex, buffer.data(), buffer.size(), 0);
+    mz_zip_reader_end(&archive);
+
+    if (!extracted) {
+        LogError("The file '%s' could not be extracted from the archive", filename.c_str());
+        return false;
+    }
+    return this->LoadBuffer(buffer, true);
 #else
     LogError("MXL import is not supported in this build.");
     return false;
@@ -450,24 +496,37 @@ bool Toolkit::LoadZipData(const std::vector<unsigned char> &bytes)
 bool Toolkit::LoadZipDataBase64(const std::string &data)
 {
     std::vector<unsigned char> bytes = Base64Decode(data);
-    return this->LoadZipData(bytes);
+    return this->LoadZipData(std::string_view(reinterpret_cast<const char *>(bytes.data()), bytes.size()));
 }
 
 bool Toolkit::LoadZipDataBuffer(const unsigned char *data, int length)
 {
-    std::vector<unsigned char> bytes(data, data + length);
-    return this->LoadZipData(bytes);
+    return this->LoadZipData(std::string_view(reinterpret_cast<const char *>(data), length));
 }
 
 bool Toolkit::LoadData(const std::string &data)
+{
+    return this->LoadBuffer(data, false);
+}
+
+bool Toolkit::LoadBuffer(std::string_view data, bool inPlace)
 {
     std::string newData;
     Input *input = NULL;
 
-    if (m_options->m_xmlIdChecksum.GetValue()) {
+    m_renderCache.Clear();
+    m_displayLists.clear();
+    m_dataChecksum = 0;
+    m_snapshot.clear();
+    m_glyphSpriteCodes.clear();
+
+    if (m_options->m_xmlIdChecksum.GetValue() || (m_options->m_renderCacheSize.GetValue() > 0)) {
         crcInit();
-        unsigned int cr = crcFast((unsigned char *)data.c_str(), (int)data.size());
-        Object::SeedID(cr);
+        m_dataChecksum = crcFast((unsigned char *)data.data(), (int)data.size());
+    }
+
+    if (m_options->m_xmlIdChecksum.GetValue()) {
+        Object::SeedID(m_dataChecksum);
     }
 
 #ifndef NO_HUMDRUM_SUPPORT
@@ -566,6 +625,9 @@ bool Toolkit::LoadData(const std::string &data)
     else if (inputFormat == MEI) {
         input = new MEIInput(&m_doc);
     }
+    else if (inputFormat == SNAPSHOT) {
+        input = new SnapshotInput(&m_doc);
+    }
     else if (inputFormat == MUSICXML) {
         // This is the direct converter from MusicXML to MEI using iomusicxml:
         input = new MusicXmlInput(&m_doc);
@@ -575,7 +637,7 @@ bool Toolkit::LoadData(const std::string &data)
         // This is the indirect converter from MusicXML to MEI using iohumdrum:
         hum::Tool_musicxml2hum converter;
         pugi::xml_document xmlfile;
-        xmlfile.load_string(data.c_str());
+        xmlfile.load_buffer(data.data(), data.size(), pugi::parse_default, pugi::encoding_utf8);
         stringstream conversion;
         bool status = converter.convert(conversion, xmlfile);
         if (!status) {
@@ -602,7 +664,7 @@ bool Toolkit::LoadData(const std::string &data)
     }
 
     else if (inputFormat == MEIHUM) {
-        ConvertMEIToHumdrum(data);
+        ConvertMEIToHumdrum(std::string(data));
 
         // Now convert Humdrum into MEI:
         std::string conversion = this->GetHumdrumBuffer();
@@ -625,7 +687,7 @@ bool Toolkit::LoadData(const std::string &data)
         // This is the indirect converter from MuseData to MEI using iohumdrum:
         hum::Tool_musedata2hum converter;
         stringstream conversion;
-        bool status = converter.convertString(conversion, data);
+        bool status = converter.convertString(conversion, std::string(data));
         if (!status) {
             LogError("Error converting MuseData data");
             return false;
@@ -653,7 +715,7 @@ bool Toolkit::LoadData(const std::string &data)
         // This is the indirect converter from EsAC to MEI using iohumdrum:
         hum::Tool_esac2hum converter;
         stringstream conversion;
-        bool status = converter.convert(conversion, data);
+        bool status = converter.convert(conversion, std::string(data));
         if (!status) {
             LogError("Error converting EsAC data");
             return false;
@@ -690,13 +752,30 @@ bool Toolkit::LoadData(const std::string &data)
 
     // load the file
     if (inputFormat != HUMDRUM) {
-        if (!input->Import(newData.size() ? newData : data)) {
+        bool success = false;
+        if (!newData.empty()) {
+            success = input->Import(newData);
+        }
+        // Only a buffer we are allowed to modify (e.g., a private file mapping) is parsed in place
+        else if (inPlace) {
+            success = input->ImportInPlace(const_cast<char *>(data.data()), data.size());
+        }
+        else {
+            success = input->Import(data);
+        }
+        if (!success) {
             LogError("Error importing data");
             delete input;
             return false;
         }
     }
 
+    // Keep a snapshot of the document as imported, before the data preparation and the layout
+    if (this->GetOutputTo() == SNAPSHOT) {
+        SnapshotOutput snapshotOutput(&m_doc, input->GetLayoutInformation());
+        m_snapshot = snapshotOutput.GetOutput();
+    }
+
     bool adjustPageHeight = m_options->m_adjustPageHeight.GetValue();
     int footerOption = m_options->m_footer.GetValue();
     // With adjusted page height, show the footer if explicitly set (i.e., not with "auto")
@@ -746,6 +825,9 @@ bool Toolkit::LoadData(const std::string &data)
     // to be converted
     if (m_doc.GetType() == Transcription || m_doc.GetType() == Facs) breaks = BREAKS_none;
 
+    // No layout is needed when only the performance (MIDI, timemap or features) is output
+    if (m_options->m_performanceOnly.GetValue()) breaks = BREAKS_none;
+
     if (!m_skipLayoutOnLoad && (breaks != BREAKS_none)) {
         if (input->GetLayoutInformation() == LAYOUT_ENCODED
             && (breaks == BREAKS_encoded || breaks == BREAKS_line || breaks == BREAKS_smart)) {
@@ -772,7 +854,12 @@ bool Toolkit::LoadData(const std::string &data)
                 LogWarning("Requesting layout with smart breaks but nothing provided in the data");
             }
             // LogElapsedTimeStart();
-            m_doc.CastOffDoc();
+            if (breaks == BREAKS_optimal) {
+                m_doc.CastOffOptimalDoc();
+            }
+            else {
+                m_doc.CastOffDoc();
+            }
             // LogElapsedTimeEnd("cast-off");
         }
     }
@@ -804,6 +891,25 @@ void Toolkit::SkipLayoutOnLoad(bool value)
 }
 
 std::string Toolkit::GetMEI(const std::string &jsonOptions)
+{
+    if (this->GetPageCount() == 0) {
+        LogWarning("No data loaded");
+        return "";
+    }
+
+    const std::string cacheKey = this->GetRenderCacheKey(RENDER_CACHE_MEI, 0, jsonOptions);
+    std::string output;
+    if (!cacheKey.empty() && m_renderCache.Get(cacheKey, output)) return output;
+
+    std::ostringstream stream;
+    if (!this->WriteMEI(stream, jsonOptions)) return "";
+    output = stream.str();
+
+    if (!cacheKey.empty()) m_renderCache.Add(cacheKey, output);
+    return output;
+}
+
+bool Toolkit::WriteMEI(std::ostream &stream, const std::string &jsonOptions)
 {
     bool scoreBased = true;
     bool basic = false;
@@ -839,18 +945,13 @@ std::string Toolkit::GetMEI(const std::string &jsonOptions)
         }
     }
 
-    if (this->GetPageCount() == 0) {
-        LogWarning("No data loaded");
-        return "";
-    }
-
     int initialPageNo = (m_doc.GetDrawingPage() == NULL) ? -1 : m_doc.GetDrawingPage()->GetIdx();
 
     bool hadSelection = false;
     if (m_doc.HasSelection()) {
         if (!scoreBased) {
             LogError("Page-based MEI output is not possible when a selection is set.");
-            return "";
+            return false;
         }
         hadSelection = true;
         m_doc.DeactiveateSelection();
@@ -871,12 +972,13 @@ std::string Toolkit::GetMEI(const std::string &jsonOptions)
     if (!lastMeasure.empty()) meioutput.SetLastMeasure(lastMeasure);
     if (!mdiv.empty()) meioutput.SetMdiv(mdiv);
 
-    std::string output = meioutput.GetOutput();
+    const bool success = meioutput.Export(stream);
 
     if (hadSelection) m_doc.ReactivateSelection(false);
 
     if (initialPageNo >= 0) m_doc.SetDrawingPage(initialPageNo);
-    return output;
+
+    return success;
 }
 
 std::string Toolkit::ValidatePAEFile(const std::string &filename)
@@ -899,8 +1001,8 @@ std::string Toolkit::ValidatePAE(const std::string &data)
 
 bool Toolkit::SaveFile(const std::string &filename, const std::string &jsonOptions)
 {
-    std::string output = this->GetMEI(jsonOptions);
-    if (output.empty()) {
+    if (this->GetPageCount() == 0) {
+        LogWarning("No data loaded");
         return false;
     }
 
@@ -912,7 +1014,26 @@ bool Toolkit::SaveFile(const std::string &filename, const std::string &jsonOptio
         return false;
     }
 
-    outfile << output;
+    // The MEI is streamed directly to the file
+    const bool success = this->WriteMEI(outfile, jsonOptions);
+    outfile.close();
+    return success;
+}
+
+bool Toolkit::SaveSnapshot(const std::string &filename)
+{
+    if (m_snapshot.empty()) {
+        LogError("No snapshot available, the output has to be set to 'snapshot' before loading the data");
+        return false;
+    }
+
+    std::ofstream outfile(filename.c_str(), std::ios::binary);
+    if (!outfile.is_open()) {
+        LogError("Unable to write the snapshot to %s", filename.c_str());
+        return false;
+    }
+
+    outfile.write(m_snapshot.data(), m_snapshot.size());
     outfile.close();
     return true;
 }
@@ -1104,6 +1225,9 @@ bool Toolkit::SetOptions(const std::string &jsonOptions)
 
     m_options->Sync();
 
+    m_renderCache.Clear();
+    m_doc.GetResourcesForModification().ResetTextExtentCache();
+
     // Forcing font resource to be reset if the font is given in the options
     if (json.has<jsonxx::String>("font")) this->SetFont(m_options->m_font.GetValue());
 
@@ -1115,6 +1239,8 @@ void Toolkit::ResetOptions()
     std::for_each(m_options->GetItems()->begin(), m_options->GetItems()->end(),
         [](const MapOfStrOptions::value_type &opt) { opt.second->Reset(); });
 
+    m_renderCache.Clear();
+
     // Set the (default) font
     this->SetFont(m_options->m_font.GetValue());
 }
@@ -1210,6 +1336,9 @@ bool Toolkit::Edit(const std::string &editorAction)
 {
     this->ResetLogBuffer();
 
+    m_renderCache.Clear();
+    m_displayLists.clear();
+
     return m_editorToolkit->ParseEditorAction(editorAction);
 }
 
@@ -1218,14 +1347,140 @@ std::string Toolkit::EditInfo()
     return m_editorToolkit->EditInfo();
 }
 
-std::string Toolkit::GetLog()
+std::string Toolkit::GetLog(const std::string &jsonOptions)
 {
-    std::string str;
-    std::vector<std::string>::iterator iter;
-    for (iter = logBuffer.begin(); iter != logBuffer.end(); ++iter) {
-        str += (*iter);
+    bool diagnostics = false;
+
+    jsonxx::Object json;
+
+    // Read JSON options if not empty
+    if (!jsonOptions.empty()) {
+        if (!json.parse(jsonOptions)) {
+            LogWarning("Cannot parse JSON std::string. Using default options.");
+        }
+        else {
+            if (json.has<jsonxx::Boolean>("diagnostics")) diagnostics = json.get<jsonxx::Boolean>("diagnostics");
+        }
+    }
+
+    const std::vector<std::string> logBuffer = GetLogBuffer();
+
+    if (!diagnostics) {
+        std::string str;
+        std::vector<std::string>::const_iterator iter;
+        for (iter = logBuffer.begin(); iter != logBuffer.end(); ++iter) {
+            str += (*iter);
+        }
+        return str;
     }
-    return str;
+
+    jsonxx::Array messages;
+    for (const std::string &message : logBuffer) {
+        messages << message;
+    }
+
+    int total = 0;
+    jsonxx::Array codes;
+    for (const auto &[code, codeCount] : GetLogCodeCounts()) {
+        jsonxx::Object o;
+        o << "code" << code;
+        switch (codeCount.m_level) {
+            case LOG_DEBUG: o << "level" << "debug"; break;
+            case LOG_ERROR: o << "level" << "error"; break;
+            case LOG_INFO: o << "level" << "info"; break;
+            default: o << "level" << "warning"; break;
+        }
+        o << "count" << codeCount.m_count;
+        codes << o;
+        total += codeCount.m_count;
+    }
+
+    jsonxx::Object o;
+    o << "messages" << messages;
+    o << "codes" << codes;
+    o << "total" << total;
+    return o.json();
+}
+
+std::string Toolkit::GetCacheStatistics()
+{
+    m_renderCache.SetMaxSize(m_options->m_renderCacheSize.GetValue());
+
+    jsonxx::Object renderCache;
+    renderCache << "maxSize" << (int)m_renderCache.GetMaxSize();
+    renderCache << "size" << (int)m_renderCache.GetSize();
+    renderCache << "entries" << m_renderCache.GetEntryCount();
+    renderCache << "hits" << m_renderCache.GetHits();
+    renderCache << "misses" << m_renderCache.GetMisses();
+    renderCache << "evictions" << m_renderCache.GetEvictions();
+
+    const Resources &resources = m_doc.GetResources();
+    jsonxx::Object textExtentCache;
+    textExtentCache << "entries" << resources.GetTextExtentCacheEntryCount();
+    textExtentCache << "hits" << resources.GetTextExtentCacheHits();
+    textExtentCache << "misses" << resources.GetTextExtentCacheMisses();
+
+    jsonxx::Object o;
+    o << "renderCache" << renderCache;
+    o << "textExtentCache" << textExtentCache;
+    return o.json();
+}
+
+std::string Toolkit::GetRenderCacheKey(RenderCacheType type, int pageNo, const std::string &params)
+{
+    m_renderCache.SetMaxSize(m_options->m_renderCacheSize.GetValue());
+    if (!m_renderCache.IsEnabled()) return "";
+
+    // The output cached before a change of the doc structure (e.g., the mensural conversion when writing MEI)
+    // can differ from the one rendered now
+    if (m_doc.GetStructureGeneration() != m_renderCacheGeneration) {
+        m_renderCache.Clear();
+        m_renderCacheGeneration = m_doc.GetStructureGeneration();
+    }
+
+    return RenderCache::MakeKey(m_dataChecksum, this->GetOptionsChecksum(), type, pageNo, params);
+}
+
+unsigned int Toolkit::GetOptionsChecksum() const
+{
+    const std::string options = this->GetOptions(false);
+    crcInit();
+    return crcFast((unsigned char *)options.data(), (int)options.size());
+}
+
+DisplayListDeviceContext *Toolkit::GetDisplayList(int pageIdx, DeviceContext *deviceContext)
+{
+    // The options can be modified directly, so we cannot rely on SetOptions for discarding the lists
+    const unsigned int optionsChecksum = this->GetOptionsChecksum();
+    // The lists point to the objects of the doc, which are deleted when the doc structure changes
+    const unsigned int generation = m_doc.GetStructureGeneration();
+    if ((optionsChecksum != m_displayListsChecksum) || (generation != m_displayListsGeneration)) {
+        m_displayLists.clear();
+        m_displayListsChecksum = optionsChecksum;
+        m_displayListsGeneration = generation;
+    }
+
+    // The View uses the size and the styling of the device context when drawing
+    auto iter = m_displayLists.find(pageIdx);
+    if ((iter != m_displayLists.end()) && (iter->second->GetWidth() == deviceContext->GetWidth())
+        && (iter->second->GetHeight() == deviceContext->GetHeight())
+        && (iter->second->UseGlobalStyling() == deviceContext->UseGlobalStyling())) {
+        return iter->second.get();
+    }
+
+    auto displayList = std::make_unique<DisplayListDeviceContext>(deviceContext->UseGlobalStyling());
+    displayList->SetResources(
+        (deviceContext->HasResources()) ? deviceContext->GetResources() : &m_doc.GetResources());
+    displayList->SetWidth(deviceContext->GetWidth());
+    displayList->SetHeight(deviceContext->GetHeight());
+    displayList->SetUserScale(deviceContext->GetUserScaleX(), deviceContext->GetUserScaleY());
+    const auto [baseWidth, baseHeight] = deviceContext->GetBaseSize();
+    displayList->SetBaseSize(baseWidth, baseHeight);
+    m_view.DrawCurrentPage(displayList.get(), false);
+
+    DisplayListDeviceContext *recorded = displayList.get();
+    m_displayLists[pageIdx] = std::move(displayList);
+    return recorded;
 }
 
 std::string Toolkit::GetVersion()
@@ -1241,7 +1496,9 @@ void Toolkit::ResetXmlIdSeed(int seed)
 
 void Toolkit::ResetLogBuffer()
 {
-    logBuffer.clear();
+    if (!m_resetsLogBuffer) return;
+
+    ClearLogBuffer();
 }
 
 void Toolkit::RedoLayout(const std::string &jsonOptions)
@@ -1262,6 +1519,9 @@ void Toolkit::RedoLayout(const std::string &jsonOptions)
 
     this->ResetLogBuffer();
 
+    m_renderCache.Clear();
+    m_displayLists.clear();
+
     if ((this->GetPageCount() == 0) || (m_doc.GetType() == Transcription) || (m_doc.GetType() == Facs)) {
         LogWarning("No data to re-layout");
         return;
@@ -1283,6 +1543,9 @@ void Toolkit::RedoLayout(const std::string &jsonOptions)
     else if (m_options->m_breaks.GetValue() == BREAKS_smart) {
         m_doc.CastOffSmartDoc();
     }
+    else if (m_options->m_breaks.GetValue() == BREAKS_optimal) {
+        m_doc.CastOffOptimalDoc();
+    }
     else if (m_options->m_breaks.GetValue() != BREAKS_none) {
         m_doc.CastOffDoc();
     }
@@ -1292,6 +1555,9 @@ void Toolkit::RedoPagePitchPosLayout()
 {
     this->ResetLogBuffer();
 
+    m_renderCache.Clear();
+    m_displayLists.clear();
+
     Page *page = m_doc.GetDrawingPage();
 
     if (!page) {
@@ -1353,8 +1619,14 @@ bool Toolkit::RenderToDeviceContext(int pageNo, DeviceContext *deviceContext)
         deviceContext->SetHeight(m_doc.GetFacsimile()->GetMaxY());
     }
 
-    // render the page
-    m_view.DrawCurrentPage(deviceContext, false);
+    // render the page - bounding boxes are updated only when the View code is run, and the SVG bounding boxes
+    // depend on the current floating positioners set while drawing, so they cannot be replayed
+    if (deviceContext->Is(BBOX_DEVICE_CONTEXT) || m_options->m_svgBoundingBoxes.GetValue()) {
+        m_view.DrawCurrentPage(deviceContext, false);
+    }
+    else {
+        this->GetDisplayList(pageNo, deviceContext)->Replay(deviceContext);
+    }
 
     return true;
 }
@@ -1367,53 +1639,180 @@ std::string Toolkit::RenderData(const std::string &data, const std::string &json
     return "";
 }
 
+std::string Toolkit::RenderTranspositions(const std::string &data, const std::string &jsonOptions)
+{
+    this->ResetLogBuffer();
+
+    jsonxx::Object json;
+    if (!json.parse(jsonOptions)) {
+        LogError("Cannot parse JSON std::string.");
+        return "";
+    }
+    if (!json.has<jsonxx::Array>("transpositions")) {
+        LogError("A list of transpositions is required");
+        return "";
+    }
+    std::vector<std::string> transpositions;
+    const jsonxx::Array &values = json.get<jsonxx::Array>("transpositions");
+    for (int i = 0; i < (int)values.size(); ++i) {
+        if (!values.has<jsonxx::String>(i)) {
+            LogError("Transpositions have to be given as strings");
+            return "";
+        }
+        transpositions.push_back(values.get<jsonxx::String>(i));
+    }
+    const std::string format = json.get<jsonxx::String>("format", "svg");
+    if ((format != "svg") && (format != "mei") && (format != "midi") && (format != "timemap")) {
+        LogError("Output format '%s' is not supported for transpositions", format.c_str());
+        return "";
+    }
+    const int pageNo = json.get<jsonxx::Number>("pageNo", 0);
+    int threadCount = json.get<jsonxx::Number>("threads", std::thread::hardware_concurrency());
+    threadCount = std::clamp(threadCount, 1, std::max(1, (int)transpositions.size()));
+
+    std::vector<jsonxx::Object> outputs(transpositions.size());
+    std::atomic<int> next = 0;
+
+    // Each worker uses its own toolkit with a copy of the options and of the loaded fonts
+    // The workers log to the buffer of the caller without clearing it
+    auto renderTranspositions = [&]() {
+        Toolkit toolkit(false);
+        toolkit.m_resetsLogBuffer = false;
+        toolkit.m_doc.GetResourcesForModification() = m_doc.GetResources();
+        *toolkit.m_options = *m_options;
+        toolkit.m_inputFrom = m_inputFrom;
+        toolkit.SkipLayoutOnLoad((format == "midi") || (format == "timemap"));
+        for (int i = next++; i < (int)transpositions.size(); i = next++) {
+            jsonxx::Object &output = outputs.at(i);
+            output << "transposition" << transpositions.at(i);
+            toolkit.m_options->m_transpose.SetValue(transpositions.at(i));
+            // The generator of IDs is per thread and has to be seeded for each transposition
+            Object::SeedID(m_options->m_xmlIdSeed.GetValue());
+            if (!toolkit.LoadData(data)) {
+                output << "error" << "The data could not be loaded";
+                continue;
+            }
+            if (format == "svg") {
+                jsonxx::Array pages;
+                const int first = (pageNo > 0) ? pageNo : 1;
+                const int last = (pageNo > 0) ? pageNo : toolkit.GetPageCount();
+                for (int page = first; page <= last; ++page) pages << toolkit.RenderToSVG(page);
+                output << format << pages;
+            }
+            else if (format == "mei") {
+                output << format << toolkit.GetMEI();
+            }
+            else if (format == "midi") {
+                output << format << toolkit.RenderToMIDI();
+            }
+            else {
+                output << format << toolkit.RenderToTimemap();
+            }
+        }
+    };
+
+#ifdef __EMSCRIPTEN__
+    // No threads in the WASM build
+    renderTranspositions();
+#else
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadCount; ++i) threads.emplace_back(renderTranspositions);
+    for (std::thread &thread : threads) thread.join();
+#endif
+
+    jsonxx::Array results;
+    for (const jsonxx::Object &output : outputs) results << output;
+    return results.json();
+}
+
 std::string Toolkit::RenderToSVG(int pageNo, bool xmlDeclaration)
 {
     this->ResetLogBuffer();
 
-    int initialPageNo = (m_doc.GetDrawingPage() == NULL) ? -1 : m_doc.GetDrawingPage()->GetIdx();
+    const std::string cacheKey = this->GetRenderCacheKey(RENDER_CACHE_SVG, pageNo, (xmlDeclaration) ? "xml" : "");
+    std::string out_str;
+    if (!cacheKey.empty() && m_renderCache.Get(cacheKey, out_str)) return out_str;
+
     // Create the SVG object, h & w come from the system
     // We will need to set the size of the page after having drawn it depending on the options
     SvgDeviceContext svg;
-    svg.SetResources(&m_doc.GetResources());
+    this->RenderToSvgDeviceContext(pageNo, &svg);
+
+    out_str = svg.GetStringSVG(xmlDeclaration);
+
+    if (!cacheKey.empty()) m_renderCache.Add(cacheKey, out_str);
+    return out_str;
+}
+
+void Toolkit::RenderToSvgDeviceContext(int pageNo, SvgDeviceContext *svg)
+{
+    assert(svg);
+
+    int initialPageNo = (m_doc.GetDrawingPage() == NULL) ? -1 : m_doc.GetDrawingPage()->GetIdx();
+    svg->SetResources(&m_doc.GetResources());
 
     int indent = (m_options->m_outputIndentTab.GetValue()) ? -1 : m_options->m_outputIndent.GetValue();
-    svg.SetIndent(indent);
+    svg->SetIndent(indent);
 
     if (m_options->m_mmOutput.GetValue()) {
-        svg.SetMMOutput(true);
+        svg->SetMMOutput(true);
     }
 
     if (m_doc.GetType() == Facs) {
-        svg.SetFacsimile(true);
+        svg->SetFacsimile(true);
     }
 
     // set the option to use viewbox on svg root
     if (m_options->m_svgBoundingBoxes.GetValue()) {
-        svg.SetSvgBoundingBoxes(true);
+        svg->SetSvgBoundingBoxes(true);
     }
 
     // set the additional CSS if any
     if (!m_options->m_svgCss.GetValue().empty()) {
-        svg.SetCss(m_options->m_svgCss.GetValue());
+        svg->SetCss(m_options->m_svgCss.GetValue());
     }
 
     if (m_options->m_svgViewBox.GetValue()) {
-        svg.SetSvgViewBox(true);
+        svg->SetSvgViewBox(true);
     }
 
-    svg.SetHtml5(m_options->m_svgHtml5.GetValue());
-    svg.SetFormatRaw(m_options->m_svgFormatRaw.GetValue());
-    svg.SetRemoveXlink(m_options->m_svgRemoveXlink.GetValue());
-    svg.SetAdditionalAttributes(m_options->m_svgAdditionalAttribute.GetValue());
-    svg.SetSmuflTextFont((option_SMUFLTEXTFONT)m_options->m_smuflTextFont.GetValue());
+    svg->SetHtml5(m_options->m_svgHtml5.GetValue());
+    svg->SetFormatRaw(m_options->m_svgFormatRaw.GetValue());
+    svg->SetRemoveXlink(m_options->m_svgRemoveXlink.GetValue());
+    svg->SetGlyphSprite(m_options->m_svgGlyphSprite.GetValue());
+    svg->SetCompact(m_options->m_svgCompact.GetValue());
+    svg->SetStripIds(m_options->m_svgStripIds.GetValue());
+    svg->SetAdditionalAttributes(m_options->m_svgAdditionalAttribute.GetValue());
+    svg->SetSmuflTextFont((option_SMUFLTEXTFONT)m_options->m_smuflTextFont.GetValue());
 
     // render the page
-    this->RenderToDeviceContext(pageNo, &svg);
+    this->RenderToDeviceContext(pageNo, svg);
+
+    // keep the glyphs referenced by the page for the sprite
+    if (!m_options->m_svgGlyphSprite.GetValue().empty()) {
+        for (const Glyph *glyph : svg->GetSmuflGlyphs()) m_glyphSpriteCodes.insert(glyph->GetCodeStr());
+    }
 
-    std::string out_str = svg.GetStringSVG(xmlDeclaration);
     if (initialPageNo >= 0) m_doc.SetDrawingPage(initialPageNo);
-    return out_str;
+}
+
+bool Toolkit::WriteSVGZ(std::ostream &stream, int pageNo, bool xmlDeclaration)
+{
+#ifndef NO_MXL_SUPPORT
+    SvgDeviceContext svg;
+    this->RenderToSvgDeviceContext(pageNo, &svg);
+
+    SvgzWriter writer(stream, m_options->m_svgzLevel.GetValue());
+    svg.WriteSVG(writer, xmlDeclaration);
+    if (!writer.Finish()) {
+        LogError("The SVGZ output could not be written");
+        return false;
+    }
+    return true;
+#else
+    LogError("SVGZ output is not supported in this build");
+    return false;
+#endif /* NO_MXL_SUPPORT */
 }
 
 bool Toolkit::RenderToSVGFile(const std::string &filename, int pageNo)
@@ -1435,6 +1834,65 @@ bool Toolkit::RenderToSVGFile(const std::string &filename, int pageNo)
     return true;
 }
 
+std::string Toolkit::RenderToSVGZBuffer(int pageNo, bool xmlDeclaration)
+{
+    this->ResetLogBuffer();
+
+    std::ostringstream stream;
+    if (!this->WriteSVGZ(stream, pageNo, xmlDeclaration)) return "";
+    return stream.str();
+}
+
+bool Toolkit::RenderToSVGZFile(const std::string &filename, int pageNo)
+{
+    this->ResetLogBuffer();
+
+    std::ofstream outfile;
+    outfile.open(filename.c_str(), std::ios::binary);
+
+    if (!outfile.is_open()) {
+        LogError("Unable to write SVGZ to %s", filename.c_str());
+        return false;
+    }
+
+    // The SVGZ is streamed directly to the file
+    const bool success = this->WriteSVGZ(outfile, pageNo, true);
+    outfile.close();
+    return success;
+}
+
+std::string Toolkit::RenderToGlyphSprite()
+{
+    this->ResetLogBuffer();
+
+    const Resources &resources = m_doc.GetResources();
+    std::vector<const Glyph *> glyphs;
+    for (const std::string &code : m_glyphSpriteCodes) {
+        const Glyph *glyph = resources.GetGlyph((char32_t)strtol(code.c_str(), NULL, 16));
+        if (glyph) glyphs.push_back(glyph);
+    }
+
+    int indent = (m_options->m_outputIndentTab.GetValue()) ? -1 : m_options->m_outputIndent.GetValue();
+    return SvgDeviceContext::GetGlyphSpriteSVG(glyphs, indent, m_options->m_svgFormatRaw.GetValue());
+}
+
+bool Toolkit::RenderToGlyphSpriteFile(const std::string &filename)
+{
+    std::string output = this->RenderToGlyphSprite();
+
+    std::ofstream outfile;
+    outfile.open(filename.c_str());
+
+    if (!outfile.is_open()) {
+        LogError("Unable to write the glyph sprite to %s", filename.c_str());
+        return false;
+    }
+
+    outfile << output;
+    outfile.close();
+    return true;
+}
+
 std::string Toolkit::GetHumdrum()
 {
     return this->GetHumdrumBuffer();
@@ -1464,17 +1922,43 @@ std::string Toolkit::RenderToMIDI()
 {
     this->ResetLogBuffer();
 
+    const std::string cacheKey = this->GetRenderCacheKey(RENDER_CACHE_MIDI, 0);
+    std::string outputstr;
+    if (!cacheKey.empty() && m_renderCache.Get(cacheKey, outputstr)) return outputstr;
+
+    std::ostringstream stream;
+    this->WriteMIDI(stream);
+    const std::string buffer = stream.str();
+    outputstr = Base64Encode(reinterpret_cast<const unsigned char *>(buffer.data()), (unsigned int)buffer.size());
+
+    if (!cacheKey.empty()) m_renderCache.Add(cacheKey, outputstr);
+    return outputstr;
+}
+
+std::string Toolkit::RenderToMIDIBuffer()
+{
+    this->ResetLogBuffer();
+
+    // The raw bytes are cached separately from the base64 encoded output of RenderToMIDI
+    const std::string cacheKey = this->GetRenderCacheKey(RENDER_CACHE_MIDI, 0, "buffer");
+    std::string outputstr;
+    if (!cacheKey.empty() && m_renderCache.Get(cacheKey, outputstr)) return outputstr;
+
+    std::ostringstream stream;
+    this->WriteMIDI(stream);
+    outputstr = stream.str();
+
+    if (!cacheKey.empty()) m_renderCache.Add(cacheKey, outputstr);
+    return outputstr;
+}
+
+void Toolkit::WriteMIDI(std::ostream &stream)
+{
     smf::MidiFile outputfile;
     outputfile.absoluteTicks();
     m_doc.ExportMIDI(&outputfile);
     outputfile.sortTracks();
-
-    std::stringstream stream;
     outputfile.write(stream);
-    std::string outputstr = Base64Encode(
-        reinterpret_cast<const unsigned char *>(stream.str().c_str()), (unsigned int)stream.str().length());
-
-    return outputstr;
 }
 
 std::string Toolkit::RenderToPAE()
@@ -1530,8 +2014,13 @@ std::string Toolkit::RenderToTimemap(const std::string &jsonOptions)
 
     this->ResetLogBuffer();
 
+    const std::string cacheKey = this->GetRenderCacheKey(RENDER_CACHE_TIMEMAP, 0, jsonOptions);
     std::string output;
+    if (!cacheKey.empty() && m_renderCache.Get(cacheKey, output)) return output;
+
     m_doc.ExportTimemap(output, includeRests, includeMeasures);
+
+    if (!cacheKey.empty()) m_renderCache.Add(cacheKey, output);
     return output;
 }
 
@@ -1637,6 +2126,43 @@ std::string Toolkit::GetDescriptiveFeatures(const std::string &options)
     return output;
 }
 
+bool Toolkit::AddToFeatureIndex(const std::string &name)
+{
+    this->ResetLogBuffer();
+
+    if (this->GetPageCount() == 0) {
+        LogWarning("No data loaded");
+        return false;
+    }
+
+    FeatureExtractor extractor("");
+    if (!m_doc.ExtractFeatures(&extractor)) return false;
+    return m_featureIndex.AddDocument(name, extractor);
+}
+
+bool Toolkit::LoadFeatureIndex(const std::string &filename)
+{
+    this->ResetLogBuffer();
+
+    return m_featureIndex.Load(filename);
+}
+
+std::string Toolkit::QueryFeatureIndex(const std::string &query)
+{
+    this->ResetLogBuffer();
+
+    std::string output;
+    m_featureIndex.Query(query, output);
+    return output;
+}
+
+bool Toolkit::SaveFeatureIndex(const std::string &filename)
+{
+    this->ResetLogBuffer();
+
+    return m_featureIndex.Save(filename);
+}
+
 int Toolkit::GetPageWithElement(const std::string &xmlId)
 {
     Object *element = m_doc.FindDescendantByID(xmlId);
@@ -1850,6 +2376,17 @@ const char *Toolkit::GetCString()
     }
 }
 
+void Toolkit::SetCBuffer(std::string &&data)
+{
+    m_cBuffer = std::move(data);
+}
+
+const unsigned char *Toolkit::GetCBuffer(int *length)
+{
+    if (length) *length = (int)m_cBuffer.size();
+    return reinterpret_cast<const unsigned char *>(m_cBuffer.data());
+}
+
 void Toolkit::ClearHumdrumBuffer()
 {
 #ifndef NO_HUMDRUM_SUPPORT
@@ -1936,9 +2473,116 @@ std::string Toolkit::ConvertHumdrumToHumdrum(const std::string &humdrumData)
 std::string Toolkit::ConvertHumdrumToMIDI(const std::string &humdrumData)
 {
 #ifndef NO_HUMDRUM_SUPPORT
-    return "TVRoZAAAAAYAAQAAAGRNVHJrAAAADQCQPHCBSJA8AAD/LwA=";
+    this->ResetLogBuffer();
+
+    hum::HumdrumFile infile;
+    if (!infile.readString(humdrumData)) {
+        LogError("Humdrum data could not be parsed");
+        return "";
+    }
+
+    smf::MidiFile outputfile;
+    outputfile.absoluteTicks();
+    const int tpq = outputfile.getTPQ();
+
+    // One MIDI track per **kern spine, track 0 holding the tempo
+    // Each track has its own channel, skipping channel 9 that General MIDI reserves for percussion, with the
+    // instrument of the instrument code of the spine (e.g., *Iflt) as in HumdrumInput::addInstrumentDefinition
+    std::vector<hum::HTp> kernStarts;
+    infile.getKernSpineStartList(kernStarts);
+    outputfile.addTracks((int)kernStarts.size());
+    outputfile.addTempo(0, 0, MIDI_TEMPO);
+    static hum::HumInstrument instruments;
+    std::map<int, std::pair<int, int>> midiTracks;
+    for (int i = 0; i < (int)kernStarts.size(); ++i) {
+        const int channel = (i % 15 < 9) ? i % 15 : i % 15 + 1;
+        midiTracks[kernStarts.at(i)->getTrack()] = { i + 1, channel };
+        for (hum::HTp token = kernStarts.at(i); token && !token->isData(); token = token->getNextToken()) {
+            // The first letter of an instrument code is lowercase
+            if (!token->isInterpretation() || (token->compare(0, 2, "*I") != 0) || (token->size() < 3)
+                || !::islower((*token)[2])) {
+                continue;
+            }
+            const int program = instruments.getGM(*token);
+            if (program >= 0) outputfile.addPatchChange(i + 1, 0, channel, program);
+            break;
+        }
+    }
+
+    // Follow the tie of a subtoken by its pitch - HumdrumToken::getTiedDuration only follows the first subtoken
+    auto getTiedDuration = [](hum::HTp token, int pitch, const std::string &subtoken) {
+        hum::HumNum duration = hum::Convert::recipToDuration(subtoken);
+        hum::HTp next = token->getNextToken();
+        while (next) {
+            if (!next->isData() || next->isNull()) {
+                next = next->getNextToken();
+                continue;
+            }
+            std::string tied;
+            for (int k = 0; k < next->getSubtokenCount(); ++k) {
+                const std::string nextSubtoken = next->getSubtoken(k);
+                if (nextSubtoken.find_first_of("_]") == std::string::npos) continue;
+                if (hum::Convert::kernToMidiNoteNumber(nextSubtoken) != pitch) continue;
+                tied = nextSubtoken;
+                break;
+            }
+            // Bad or incomplete tie
+            if (tied.empty()) break;
+            duration += hum::Convert::recipToDuration(tied);
+            if (tied.find(']') != std::string::npos) break;
+            next = next->getNextToken();
+        }
+        return duration;
+    };
+
+    for (int i = 0; i < infile.getLineCount(); ++i) {
+        hum::HumdrumLine &line = infile[i];
+        if (line.isInterpretation()) {
+            for (int j = 0; j < line.getFieldCount(); ++j) {
+                hum::HTp token = line.token(j);
+                if (!token->isKern() || (token->compare(0, 3, "*MM") != 0)) continue;
+                const double tempo = atof(token->substr(3).c_str());
+                if (tempo <= 0.0) continue;
+                outputfile.addTempo(0, std::round(line.getDurationFromStart().getFloat() * tpq), tempo);
+                // Only one tempo change per line
+                break;
+            }
+            continue;
+        }
+        if (!line.isData()) continue;
+        for (int j = 0; j < line.getFieldCount(); ++j) {
+            hum::HTp token = line.token(j);
+            if (!token->isKern() || !token->isNonNullData() || token->isRest()) continue;
+            auto iter = midiTracks.find(token->getTrack());
+            if (iter == midiTracks.end()) continue;
+            const int startTick = std::round(token->getDurationFromStart().getFloat() * tpq);
+            const int count = token->getSubtokenCount();
+            for (int k = 0; k < count; ++k) {
+                const std::string subtoken = token->getSubtoken(k);
+                // Skip rests, grace notes and tie continuations or ends
+                if (subtoken.find_first_of("rqQ_]") != std::string::npos) continue;
+                const int pitch = hum::Convert::kernToMidiNoteNumber(subtoken);
+                if ((pitch < 0) || (pitch > 127)) continue;
+                hum::HumNum duration = (subtoken.find('[') != std::string::npos)
+                    ? getTiedDuration(token, pitch, subtoken)
+                    : hum::Convert::recipToDuration(subtoken);
+                const int stopTick = std::round((token->getDurationFromStart() + duration).getFloat() * tpq);
+                if (stopTick <= startTick) continue;
+                const auto [midiTrack, channel] = iter->second;
+                outputfile.addNoteOn(midiTrack, startTick, channel, pitch, MIDI_VELOCITY);
+                outputfile.addNoteOff(midiTrack, stopTick, channel, pitch);
+            }
+        }
+    }
+    outputfile.sortTracks();
+
+    std::ostringstream stream;
+    outputfile.write(stream);
+    const std::string buffer = stream.str();
+    return Base64Encode(reinterpret_cast<const unsigned char *>(buffer.data()), (unsigned int)buffer.size());
 #else
-    return "TVRoZAAAAAYAAQAAAGRNVHJrAAAADQCQPHCBSJA8AAD/LwA=";
+    LogError("Humdrum support is not available in this build");
+    return "";
 #endif
 }
 
@@ -250,6 +250,86 @@ SystemAligner::SpacingType SystemAligner::CalculateSpacingAbove(const StaffDef *
     return spacingType;
 }
 
+//----------------------------------------------------------------------------
+// Skyline
+//----------------------------------------------------------------------------
+
+void Skyline::AddSegment(int left, int right, int value)
+{
+    assert(left < right);
+
+    m_segments.push_back({ left, right, value });
+}
+
+void Skyline::CalcEnvelope()
+{
+    m_envelope.clear();
+
+    std::sort(m_segments.begin(), m_segments.end(),
+        [](const Segment &segment1, const Segment &segment2) { return segment1.m_left < segment2.m_left; });
+
+    // Sweep the segments from left to right with a max-heap of the value and right position of the
+    // segments started. Segments already ended are removed only when they get on top of the heap.
+    std::vector<std::pair<int, int>> heap;
+    const int count = (int)m_segments.size();
+    int i = 0;
+    int x = 0;
+    while ((i < count) || !heap.empty()) {
+        if (heap.empty()) x = m_segments.at(i).m_left;
+        while ((i < count) && (m_segments.at(i).m_left == x)) {
+            heap.push_back({ m_segments.at(i).m_value, m_segments.at(i).m_right });
+            std::push_heap(heap.begin(), heap.end());
+            ++i;
+        }
+        // Segments ending at x do not overlap the ones starting at x
+        while (!heap.empty() && (heap.front().second <= x)) {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.pop_back();
+        }
+        if (heap.empty()) continue;
+        int next = heap.front().second;
+        if ((i < count) && (m_segments.at(i).m_left < next)) next = m_segments.at(i).m_left;
+        this->AddInterval(x, next, heap.front().first);
+        x = next;
+    }
+}
+
+void Skyline::AddInterval(int left, int right, int value)
+{
+    // Merge it with the previous interval when they are contiguous and have the same value
+    if (!m_envelope.empty() && (m_envelope.back().m_right == left) && (m_envelope.back().m_value == value)) {
+        m_envelope.back().m_right = right;
+    }
+    else {
+        m_envelope.push_back({ left, right, value });
+    }
+}
+
+int Skyline::GetMaxSum(const Skyline &skyline1, const Skyline &skyline2)
+{
+    int maxSum = VRV_UNSET;
+    auto iter1 = skyline1.m_envelope.begin();
+    auto iter2 = skyline2.m_envelope.begin();
+    while ((iter1 != skyline1.m_envelope.end()) && (iter2 != skyline2.m_envelope.end())) {
+        if (iter1->m_right <= iter2->m_left) {
+            ++iter1;
+        }
+        else if (iter2->m_right <= iter1->m_left) {
+            ++iter2;
+        }
+        else {
+            maxSum = std::max(maxSum, iter1->m_value + iter2->m_value);
+            if (iter1->m_right < iter2->m_right) {
+                ++iter1;
+            }
+            else {
+                ++iter2;
+            }
+        }
+    }
+    return maxSum;
+}
+
 //----------------------------------------------------------------------------
 // StaffAlignment
 //----------------------------------------------------------------------------
@@ -1150,39 +1230,88 @@ int StaffAlignment::AdjustStaffOverlap(FunctorParams *functorParams)
     const int staffSize = this->GetStaffSize();
     const int drawingUnit = params->m_doc->GetDrawingUnit(staffSize);
 
-    ArrayOfBoundingBoxes::iterator iter;
-    // go through all the elements of the top staff that have an overflow below
-    for (iter = params->m_previous->m_overflowBelowBBoxes.begin();
-         iter != params->m_previous->m_overflowBelowBBoxes.end(); ++iter) {
-        auto i = m_overflowAboveBBoxes.begin();
-        auto end = m_overflowAboveBBoxes.end();
-        while (i != end) {
-            // find all the elements from the bottom staff that have an overflow at the top with an horizontal overlap
-            i = std::find_if(i, end, [iter, drawingUnit](BoundingBox *elem) {
-                if ((*iter)->Is(FLOATING_POSITIONER)) {
-                    FloatingPositioner *fp = vrv_cast<FloatingPositioner *>(*iter);
-                    if (fp->GetObject()->Is({ DIR, DYNAM, TEMPO }) && fp->GetObject()->IsExtenderElement()) {
-                        return (*iter)->HorizontalContentOverlap(elem, drawingUnit * 4)
-                            || (*iter)->VerticalContentOverlap(elem);
-                    }
-                }
-                return (*iter)->HorizontalContentOverlap(elem);
-            });
-            if (i != end) {
-                // calculate the vertical overlap and see if this is more than the expected space
-                int overflowBelow = params->m_previous->CalcOverflowBelow(*iter);
-                int overflowAbove = this->CalcOverflowAbove(*i);
-                int minSpaceBetween = 0;
-                if (((*iter)->Is(ARTIC) && ((*i)->Is({ ARTIC, NOTE }))) || ((*iter)->Is(NOTE) && ((*i)->Is(ARTIC)))) {
-                    minSpaceBetween = drawingUnit;
-                }
-                if (spacing < (overflowBelow + overflowAbove + minSpaceBetween)) {
-                    // LogDebug("Overlap %d", (overflowBelow + overflowAbove + minSpaceBetween) - spacing);
-                    this->SetOverlap((overflowBelow + overflowAbove + minSpaceBetween) - spacing);
-                }
-                ++i;
+    // Extender elements are compared with a margin or with their vertical overlap
+    auto isExtender = [](const BoundingBox *box) {
+        if (!box->Is(FLOATING_POSITIONER)) return false;
+        const FloatingPositioner *fp = vrv_cast<const FloatingPositioner *>(box);
+        return (fp->GetObject()->Is({ DIR, DYNAM, TEMPO }) && fp->GetObject()->IsExtenderElement());
+    };
+
+    // Calculate the vertical overlap of two elements and see if this is more than the expected space
+    auto adjustOverlap = [this, params, spacing, drawingUnit, &isExtender](BoundingBox *below, BoundingBox *above) {
+        if (isExtender(below)) {
+            if (!below->HorizontalContentOverlap(above, drawingUnit * 4) && !below->VerticalContentOverlap(above)) {
+                return;
             }
         }
+        else if (!below->HorizontalContentOverlap(above)) {
+            return;
+        }
+        int overflowBelow = params->m_previous->CalcOverflowBelow(below);
+        int overflowAbove = this->CalcOverflowAbove(above);
+        int minSpaceBetween = 0;
+        if ((below->Is(ARTIC) && (above->Is({ ARTIC, NOTE }))) || (below->Is(NOTE) && (above->Is(ARTIC)))) {
+            minSpaceBetween = drawingUnit;
+        }
+        if (spacing < (overflowBelow + overflowAbove + minSpaceBetween)) {
+            // LogDebug("Overlap %d", (overflowBelow + overflowAbove + minSpaceBetween) - spacing);
+            this->SetOverlap((overflowBelow + overflowAbove + minSpaceBetween) - spacing);
+        }
+    };
+
+    // Build the skylines of the elements of the top staff that have an overflow below and of the elements
+    // of the bottom staff that have an overflow at the top. The artic and notes have their own skylines for
+    // the additional space between them. Extenders and elements with no width are compared pairwise.
+    Skyline belowAll, belowArtic, belowNote;
+    ArrayOfBoundingBoxes pairwiseBelow;
+    for (BoundingBox *below : params->m_previous->m_overflowBelowBBoxes) {
+        if (!below->HasContentBB()) continue;
+        if (isExtender(below) || (below->GetContentLeft() >= below->GetContentRight())) {
+            pairwiseBelow.push_back(below);
+            continue;
+        }
+        const int overflowBelow = params->m_previous->CalcOverflowBelow(below);
+        belowAll.AddSegment(below->GetContentLeft(), below->GetContentRight(), overflowBelow);
+        if (below->Is(ARTIC)) belowArtic.AddSegment(below->GetContentLeft(), below->GetContentRight(), overflowBelow);
+        if (below->Is(NOTE)) belowNote.AddSegment(below->GetContentLeft(), below->GetContentRight(), overflowBelow);
+    }
+    Skyline aboveAll, aboveArtic, aboveArticNote;
+    ArrayOfBoundingBoxes pairwiseAbove;
+    for (BoundingBox *above : m_overflowAboveBBoxes) {
+        if (!above->HasContentBB()) continue;
+        if (above->GetContentLeft() >= above->GetContentRight()) {
+            pairwiseAbove.push_back(above);
+            continue;
+        }
+        const int overflowAbove = this->CalcOverflowAbove(above);
+        aboveAll.AddSegment(above->GetContentLeft(), above->GetContentRight(), overflowAbove);
+        if (above->Is(ARTIC)) aboveArtic.AddSegment(above->GetContentLeft(), above->GetContentRight(), overflowAbove);
+        if (above->Is({ ARTIC, NOTE })) {
+            aboveArticNote.AddSegment(above->GetContentLeft(), above->GetContentRight(), overflowAbove);
+        }
+    }
+
+    for (Skyline *skyline : { &belowAll, &belowArtic, &belowNote, &aboveAll, &aboveArtic, &aboveArticNote }) {
+        skyline->CalcEnvelope();
+    }
+    int overflow = Skyline::GetMaxSum(belowAll, aboveAll);
+    const int articOverflow = Skyline::GetMaxSum(belowArtic, aboveArticNote);
+    if (articOverflow != VRV_UNSET) overflow = std::max(overflow, articOverflow + drawingUnit);
+    const int noteOverflow = Skyline::GetMaxSum(belowNote, aboveArtic);
+    if (noteOverflow != VRV_UNSET) overflow = std::max(overflow, noteOverflow + drawingUnit);
+    if ((overflow != VRV_UNSET) && (spacing < overflow)) {
+        this->SetOverlap(overflow - spacing);
+    }
+
+    // The elements compared pairwise
+    for (BoundingBox *below : pairwiseBelow) {
+        for (BoundingBox *above : m_overflowAboveBBoxes) adjustOverlap(below, above);
+    }
+    for (BoundingBox *above : pairwiseAbove) {
+        for (BoundingBox *below : params->m_previous->m_overflowBelowBBoxes) {
+            if (std::find(pairwiseBelow.begin(), pairwiseBelow.end(), below) != pairwiseBelow.end()) continue;
+            adjustOverlap(below, above);
+        }
     }
 
     params->m_previous = this;
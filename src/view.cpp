@@ -15,7 +15,10 @@
 //----------------------------------------------------------------------------
 
 #include "doc.h"
+#include "f.h"
 #include "page.h"
+#include "syl.h"
+#include "text.h"
 #include "vrv.h"
 
 namespace vrv {
@@ -37,6 +40,7 @@ View::View()
     m_currentMeasure = NULL;
     m_currentStaff = NULL;
     m_currentSystem = NULL;
+    m_metricCheckElement = NULL;
 }
 
 View::~View() {}
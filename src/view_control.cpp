@@ -1223,14 +1223,21 @@ void View::DrawFConnector(DeviceContext *dc, F *f, int x1, int x2, Staff *staff,
         // nothing to adjust
     }
 
-    // Because Syl is not a ControlElement (FloatingElement) with FloatingPositioner we need to instantiate a
-    // temporary object in order not to reset the Syl bounding box.
-    F fConnector;
+    // Because Syl is not a ControlElement (FloatingElement) with FloatingPositioner we need to use a
+    // separate object in order not to reset the Syl bounding box.
+    if (!m_fConnector) {
+        m_fConnector = std::make_unique<F>();
+    }
+    else {
+        // Generate a new ID as for a temporary object
+        m_fConnector->ResetID();
+    }
+    F *fConnector = m_fConnector.get();
     if (graphic) {
         dc->ResumeGraphic(graphic, graphic->GetID());
     }
     else
-        dc->StartGraphic(&fConnector, "", f->GetID(), SPANNING);
+        dc->StartGraphic(fConnector, "", f->GetID(), SPANNING);
 
     dc->DeactivateGraphic();
 
@@ -1245,7 +1252,7 @@ void View::DrawFConnector(DeviceContext *dc, F *f, int x1, int x2, Staff *staff,
         dc->EndResumedGraphic(graphic, this);
     }
     else
-        dc->EndGraphic(&fConnector, this);
+        dc->EndGraphic(fConnector, this);
 }
 
 void View::DrawSylConnector(
@@ -1297,14 +1304,21 @@ void View::DrawSylConnector(
         // nothing to adjust
     }
 
-    // Because Syl is not a ControlElement (FloatingElement) with FloatingPositioner we need to instantiate a
-    // temporary object in order not to reset the Syl bounding box.
-    Syl sylConnector;
+    // Because Syl is not a ControlElement (FloatingElement) with FloatingPositioner we need to use a
+    // separate object in order not to reset the Syl bounding box.
+    if (!m_sylConnector) {
+        m_sylConnector = std::make_unique<Syl>();
+    }
+    else {
+        // Generate a new ID as for a temporary object
+        m_sylConnector->ResetID();
+    }
+    Syl *sylConnector = m_sylConnector.get();
     if (graphic) {
         dc->ResumeGraphic(graphic, graphic->GetID());
     }
     else
-        dc->StartGraphic(&sylConnector, "", syl->GetID(), SPANNING);
+        dc->StartGraphic(sylConnector, "", syl->GetID(), SPANNING);
 
     dc->DeactivateGraphic();
 
@@ -1316,7 +1330,7 @@ void View::DrawSylConnector(
         dc->EndResumedGraphic(graphic, this);
     }
     else
-        dc->EndGraphic(&sylConnector, this);
+        dc->EndGraphic(sylConnector, this);
 }
 
 void View::DrawSylConnectorLines(DeviceContext *dc, int x1, int x2, int y, Syl *syl, Staff *staff)
@@ -2887,9 +2901,16 @@ void View::DrawEnding(DeviceContext *dc, Ending *ending, System *system)
             strStream << ending->GetN(); // << ".";
             if ((spanningType == SPANNING_END) || (spanningType == SPANNING_MIDDLE)) strStream << ")";
 
-            Text text;
-            text.SetParent(ending);
-            text.SetText(UTF8to32(strStream.str()));
+            if (!m_endingText) {
+                m_endingText = std::make_unique<Text>();
+            }
+            else {
+                // Generate a new ID as for a temporary object
+                m_endingText->ResetID();
+            }
+            Text *text = m_endingText.get();
+            text->SetParent(ending);
+            text->SetText(UTF8to32(strStream.str()));
 
             int textX = x1;
             if ((spanningType == SPANNING_START_END) || (spanningType == SPANNING_START)) {
@@ -2902,7 +2923,7 @@ void View::DrawEnding(DeviceContext *dc, Ending *ending, System *system)
             params.m_pointSize = currentFont.GetPointSize();
 
             dc->StartText(ToDeviceContextX(params.m_x), ToDeviceContextY(params.m_y), HORIZONTALALIGNMENT_left);
-            this->DrawTextElement(dc, &text, params);
+            this->DrawTextElement(dc, text, params);
             dc->EndText();
         }
 
@@ -73,6 +73,9 @@ void View::DrawLayerElement(DeviceContext *dc, LayerElement *element, Layer *lay
         return;
     }
 
+    // With the horizontal layout, the bounding boxes of notes and rests are calculated without drawing them
+    if (this->DrawLayerElementMetrics(dc, element, layer, staff, measure)) return;
+
     int previousColor = m_currentColour;
 
     if (element == m_currentElement) {
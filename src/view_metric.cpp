@@ -0,0 +1,512 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        view_metric.cpp
+// Author:      Laurent Pugin
+// Created:     18/10/2026
+// Copyright (c) Authors and others. All rights reserved.
+/////////////////////////////////////////////////////////////////////////////
+
+#include "view.h"
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cassert>
+#include <math.h>
+
+//----------------------------------------------------------------------------
+
+#include "accid.h"
+#include "bboxdevicecontext.h"
+#include "doc.h"
+#include "elementpart.h"
+#include "glyph.h"
+#include "note.h"
+#include "options.h"
+#include "resources.h"
+#include "rest.h"
+#include "staff.h"
+#include "stem.h"
+#include "vrv.h"
+
+namespace vrv {
+
+//----------------------------------------------------------------------------
+// MetricParams
+//----------------------------------------------------------------------------
+
+/**
+ * This class holds the state of the bounding box calculation from the glyph metrics.
+ * The objects are stacked as they would be in the BBoxDeviceContext, and the extent of
+ * everything calculated is kept for stretching the content bounding box of the objects
+ * on the stack of the device context.
+ */
+class MetricParams {
+public:
+    MetricParams(const Resources *resources)
+    {
+        m_resources = resources;
+        m_hasX = false;
+        m_hasY = false;
+        m_x1 = -VRV_UNSET;
+        m_x2 = VRV_UNSET;
+        m_y1 = -VRV_UNSET;
+        m_y2 = VRV_UNSET;
+    }
+
+    /**
+     * Reset the bounding box of the object and put it on the stack, as BBoxDeviceContext::StartGraphic
+     */
+    void Start(Object *object)
+    {
+        object->BoundingBox::ResetBoundingBox();
+        m_objects.push_back(object);
+        m_calculated.push_back(object);
+    }
+
+    void End() { m_objects.pop_back(); }
+
+public:
+    const Resources *m_resources;
+    std::vector<Object *> m_objects;
+    /** All the objects calculated, used for the check */
+    std::vector<Object *> m_calculated;
+    /** The extent of everything calculated, in logical coordinates */
+    bool m_hasX;
+    bool m_hasY;
+    int m_x1, m_x2, m_y1, m_y2;
+};
+
+//----------------------------------------------------------------------------
+// Helpers
+//----------------------------------------------------------------------------
+
+// The duration of the notehead, as in View::DrawNote
+static int GetMetricNoteDur(const Note *note)
+{
+    int drawingDur = note->GetDrawingDur();
+    if (drawingDur == DUR_NONE) drawingDur = DUR_4;
+    return ((note->GetColored() == BOOLEAN_true) && drawingDur > DUR_1) ? (drawingDur + 1) : drawingDur;
+}
+
+// The bounding box values of an object, for comparing the calculated and the drawn ones
+struct MetricBBoxValues {
+    int m_values[8];
+    char32_t m_glyph;
+    int m_glyphFontSize;
+
+    MetricBBoxValues(const Object *object)
+        : m_values{ object->GetSelfX1(), object->GetSelfX2(), object->GetSelfY1(), object->GetSelfY2(),
+            object->GetContentX1(), object->GetContentX2(), object->GetContentY1(), object->GetContentY2() }
+    {
+        m_glyph = object->GetBoundingBoxGlyph();
+        m_glyphFontSize = object->GetBoundingBoxGlyphFontSize();
+    }
+
+    bool operator==(const MetricBBoxValues &other) const
+    {
+        return std::equal(m_values, m_values + 8, other.m_values) && (m_glyph == other.m_glyph)
+            && (m_glyphFontSize == other.m_glyphFontSize);
+    }
+};
+
+//----------------------------------------------------------------------------
+// View - LayerElement metrics
+//----------------------------------------------------------------------------
+
+bool View::DrawLayerElementMetrics(
+    DeviceContext *dc, LayerElement *element, Layer *layer, Staff *staff, Measure *measure)
+{
+    assert(dc);
+    assert(element);
+    assert(staff);
+
+    if (!element->Is({ NOTE, REST }) || !dc->Is(BBOX_DEVICE_CONTEXT)) return false;
+    // We are drawing the element for checking the calculated bounding boxes
+    if (element == m_metricCheckElement) return false;
+
+    BBoxDeviceContext *bBoxDC = vrv_cast<BBoxDeviceContext *>(dc);
+    assert(bBoxDC);
+    if (bBoxDC->UpdateVerticalValues() || !bBoxDC->IsGraphicActive()) return false;
+
+    if (!this->IsMetricSupported(element, staff)) return false;
+
+    MetricParams params(dc->GetResources());
+    assert(params.m_resources);
+    this->CalcMetricElement(params, element, staff);
+    assert(params.m_objects.empty());
+
+    if (!m_options->m_metricLayoutCheck.GetValue()) {
+        bBoxDC->UpdateContentBB(params.m_x1, params.m_y1, params.m_x2, params.m_y2, params.m_hasX, params.m_hasY);
+        return true;
+    }
+
+    // Draw the element and compare the bounding boxes with the calculated ones
+    std::vector<MetricBBoxValues> calculated;
+    for (Object *object : params.m_calculated) calculated.push_back(MetricBBoxValues(object));
+
+    LayerElement *previousCheckElement = m_metricCheckElement;
+    m_metricCheckElement = element;
+    this->DrawLayerElement(dc, element, layer, staff, measure);
+    m_metricCheckElement = previousCheckElement;
+
+    for (int i = 0; i < (int)params.m_calculated.size(); ++i) {
+        Object *object = params.m_calculated.at(i);
+        if (calculated.at(i) == MetricBBoxValues(object)) continue;
+        LogWarning("The bounding box of %s '%s' calculated from the glyph metrics differs from the drawn one",
+            object->GetClassName().c_str(), object->GetID().c_str());
+    }
+
+    return true;
+}
+
+bool View::IsMetricSupported(LayerElement *element, Staff *staff)
+{
+    assert(element);
+    assert(staff);
+
+    if (element->HasSameas()) return false;
+
+    if (element->Is(ACCID)) {
+        Accid *accid = vrv_cast<Accid *>(element);
+        assert(accid);
+        if (accid->HasAccid() && !staff->IsTablature()) {
+            if (accid->HasPlace() || (accid->GetFunc() == accidLog_FUNC_edit)) return false;
+        }
+    }
+    else if (element->Is(DOTS)) {
+        Dots *dots = vrv_cast<Dots *>(element);
+        assert(dots);
+        for (const auto &mapEntry : dots->GetMapOfDotLocs()) {
+            const Staff *dotStaff = (mapEntry.first) ? mapEntry.first : staff;
+            if (dotStaff->IsMensural()) return false;
+        }
+    }
+    else if (element->Is(FLAG)) {
+        // Nothing to check
+    }
+    else if (element->Is(NOTE)) {
+        Note *note = vrv_cast<Note *>(element);
+        assert(note);
+        if (note->IsMensuralDur() || note->IsTabGrpNote() || note->HasStemSameasNote()) return false;
+        // Maxima and longa are drawn with DrawMaximaToBrevis
+        if ((note->GetHeadVisible() != BOOLEAN_false) && (GetMetricNoteDur(note) < DUR_BR)) return false;
+        if (note->m_crossStaff) staff = note->m_crossStaff;
+    }
+    else if (element->Is(REST)) {
+        Rest *rest = vrv_cast<Rest *>(element);
+        assert(rest);
+        if (rest->m_crossStaff) staff = rest->m_crossStaff;
+    }
+    else if (element->Is(STEM)) {
+        Stem *stem = vrv_cast<Stem *>(element);
+        assert(stem);
+        // Virtual stems are not drawn, nor their children
+        if (stem->IsVirtual()) return true;
+        const data_STEMMODIFIER stemMod = stem->GetDrawingStemMod();
+        if ((stemMod != STEMMODIFIER_NONE) && (stemMod != STEMMODIFIER_none)) return false;
+        // Acciaccatura slash
+        if ((stem->GetGrace() == GRACE_unacc) && !stem->IsInBeam()) return false;
+    }
+    else {
+        return false;
+    }
+
+    for (Object *child : element->GetChildren()) {
+        if (child->IsEditorialElement()) return false;
+        if (!child->IsLayerElement()) continue;
+        if (!this->IsMetricSupported(vrv_cast<LayerElement *>(child), staff)) return false;
+    }
+
+    return true;
+}
+
+void View::CalcMetricElement(MetricParams &params, LayerElement *element, Staff *staff)
+{
+    assert(element);
+    assert(staff);
+
+    if (element->Is(ACCID)) {
+        Accid *accid = vrv_cast<Accid *>(element);
+        assert(accid);
+        params.Start(accid);
+        if (!accid->HasAccid() || staff->IsTablature()) {
+            accid->SetEmptyBB();
+        }
+        else {
+            this->CalcMetricGlyphs(params, accid->GetDrawingX(), accid->GetDrawingY(),
+                accid->GetSymbolStr(staff->m_drawingNotationType), staff->m_drawingStaffSize,
+                accid->GetDrawingCueSize(), true, true);
+        }
+        params.End();
+    }
+    else if (element->Is(DOTS)) {
+        Dots *dots = vrv_cast<Dots *>(element);
+        assert(dots);
+        params.Start(dots);
+        const int unit = m_doc->GetDrawingUnit(staff->m_drawingStaffSize);
+        for (const auto &mapEntry : dots->GetMapOfDotLocs()) {
+            const Staff *dotStaff = (mapEntry.first) ? mapEntry.first : staff;
+            int y = dotStaff->GetDrawingY()
+                - m_doc->GetDrawingDoubleUnit(staff->m_drawingStaffSize) * (dotStaff->m_drawingLines - 1);
+            int x = dots->GetDrawingX() + unit;
+            for (int loc : mapEntry.second) {
+                this->CalcMetricDots(params, x, y + loc * unit, dots->GetDots(), dotStaff, dots->GetDrawingCueSize());
+            }
+        }
+        params.End();
+    }
+    else if (element->Is(FLAG)) {
+        Flag *flag = vrv_cast<Flag *>(element);
+        assert(flag);
+        Stem *stem = vrv_cast<Stem *>(flag->GetFirstAncestor(STEM));
+        assert(stem);
+        // The position is taken before the bounding box is reset, as in View::DrawFlag
+        const int x = flag->GetDrawingX() - m_doc->GetDrawingStemWidth(staff->m_drawingStaffSize) / 2;
+        const int y = flag->GetDrawingY();
+        params.Start(flag);
+        const char32_t code = flag->GetFlagGlyph(stem->GetDrawingStemDir());
+        if (code) {
+            this->CalcMetricGlyphs(params, x, y, std::u32string(1, code), staff->GetDrawingStaffNotationSize(),
+                flag->GetDrawingCueSize(), false);
+        }
+        params.End();
+    }
+    else if (element->Is(NOTE)) {
+        Note *note = vrv_cast<Note *>(element);
+        assert(note);
+        params.Start(note);
+        this->CalcMetricNote(params, note, staff);
+        params.End();
+    }
+    else if (element->Is(REST)) {
+        Rest *rest = vrv_cast<Rest *>(element);
+        assert(rest);
+        params.Start(rest);
+        this->CalcMetricRest(params, rest, staff);
+        params.End();
+    }
+    else if (element->Is(STEM)) {
+        Stem *stem = vrv_cast<Stem *>(element);
+        assert(stem);
+        if (stem->IsVirtual()) return;
+        params.Start(stem);
+        this->CalcMetricLine(params, stem->GetDrawingX(), stem->GetDrawingY(), stem->GetDrawingX(),
+            stem->GetDrawingY() - (stem->GetDrawingStemLen() + stem->GetDrawingStemAdjust()),
+            m_doc->GetDrawingStemWidth(staff->m_drawingStaffSize));
+        for (Object *child : stem->GetChildren()) {
+            if (child->IsLayerElement()) this->CalcMetricElement(params, vrv_cast<LayerElement *>(child), staff);
+        }
+        params.End();
+    }
+    else {
+        // Should have been filtered out by IsMetricSupported
+        assert(false);
+    }
+}
+
+void View::CalcMetricNote(MetricParams &params, Note *note, Staff *staff)
+{
+    assert(note);
+    assert(staff);
+
+    if (note->m_crossStaff) staff = note->m_crossStaff;
+
+    const bool drawingCueSize = note->GetDrawingCueSize();
+    const int noteY = note->GetDrawingY();
+    const int noteX = note->GetDrawingX();
+
+    if (note->GetHeadVisible() != BOOLEAN_false) {
+        const int drawingDur = GetMetricNoteDur(note);
+        char32_t fontNo;
+        if (note->GetColored() == BOOLEAN_true) {
+            fontNo = (drawingDur == DUR_1) ? SMUFL_E0FA_noteheadWholeFilled : SMUFL_E0A3_noteheadHalf;
+        }
+        else {
+            fontNo = note->GetNoteheadGlyph(drawingDur);
+        }
+        this->CalcMetricGlyphs(
+            params, noteX, noteY, std::u32string(1, fontNo), staff->m_drawingStaffSize, drawingCueSize, true);
+
+        if (note->HasHeadMod() && (note->GetHeadMod() == NOTEHEADMODIFIER_paren)) {
+            this->CalcMetricGlyphs(params, noteX - note->GetDrawingRadius(m_doc), noteY,
+                std::u32string(1, SMUFL_E26A_accidentalParensLeft), staff->m_drawingStaffSize, drawingCueSize, true);
+            this->CalcMetricGlyphs(params, noteX + note->GetDrawingRadius(m_doc) * 2, noteY,
+                std::u32string(1, SMUFL_E26B_accidentalParensRight), staff->m_drawingStaffSize, drawingCueSize, true);
+        }
+    }
+
+    for (Object *child : note->GetChildren()) {
+        if (child->IsLayerElement()) this->CalcMetricElement(params, vrv_cast<LayerElement *>(child), staff);
+    }
+}
+
+void View::CalcMetricRest(MetricParams &params, Rest *rest, Staff *staff)
+{
+    assert(rest);
+    assert(staff);
+
+    if (rest->m_crossStaff) staff = rest->m_crossStaff;
+
+    const bool drawingCueSize = rest->GetDrawingCueSize();
+    int drawingDur = rest->GetActualDur();
+    if (drawingDur == DUR_NONE) drawingDur = DUR_4;
+    const char32_t drawingGlyph = rest->GetRestGlyph(drawingDur);
+
+    const int x = rest->GetDrawingX();
+    const int y = rest->GetDrawingY();
+
+    if (drawingGlyph) {
+        this->CalcMetricGlyphs(
+            params, x, y, std::u32string(1, drawingGlyph), staff->m_drawingStaffSize, drawingCueSize, false);
+    }
+
+    // Ledger lines only change the vertical bounding box
+    if ((drawingDur == DUR_1 || drawingDur == DUR_2 || drawingDur == DUR_BR)) {
+        const int width = m_doc->GetGlyphWidth(drawingGlyph, staff->m_drawingStaffSize, drawingCueSize);
+        int ledgerLineThickness
+            = m_doc->GetOptions()->m_ledgerLineThickness.GetValue() * m_doc->GetDrawingUnit(staff->m_drawingStaffSize);
+        int ledgerLineExtension
+            = m_doc->GetOptions()->m_ledgerLineExtension.GetValue() * m_doc->GetDrawingUnit(staff->m_drawingStaffSize);
+        if (drawingCueSize) {
+            ledgerLineThickness *= m_doc->GetOptions()->m_graceFactor.GetValue();
+            ledgerLineExtension *= m_doc->GetOptions()->m_graceFactor.GetValue();
+        }
+        const int topMargin = staff->GetDrawingY();
+        const int bottomMargin = staff->GetDrawingY()
+            - (staff->m_drawingLines - 1) * m_doc->GetDrawingDoubleUnit(staff->m_drawingStaffSize);
+
+        if ((drawingDur == DUR_1 || drawingDur == DUR_2) && (y > topMargin || y < bottomMargin)) {
+            this->CalcMetricLine(params, x - ledgerLineExtension, y, x + width + ledgerLineExtension, y,
+                ledgerLineThickness, false);
+        }
+        else if (drawingDur == DUR_BR && (y >= topMargin || y <= bottomMargin)) {
+            const int height = m_doc->GetGlyphHeight(drawingGlyph, staff->m_drawingStaffSize, drawingCueSize);
+            if (y != topMargin) {
+                this->CalcMetricLine(params, x - ledgerLineExtension, y, x + width + ledgerLineExtension, y,
+                    ledgerLineThickness, false);
+            }
+            if (y != bottomMargin - height) {
+                this->CalcMetricLine(params, x - ledgerLineExtension, y + height, x + width + ledgerLineExtension,
+                    y + height, ledgerLineThickness, false);
+            }
+        }
+    }
+
+    for (Object *child : rest->GetChildren()) {
+        if (child->IsLayerElement()) this->CalcMetricElement(params, vrv_cast<LayerElement *>(child), staff);
+    }
+}
+
+void View::CalcMetricGlyphs(MetricParams &params, int x, int y, const std::u32string &text, int staffSize,
+    bool dimin, bool setBBGlyph, bool centered)
+{
+    const int pointSize = m_doc->GetDrawingSmuflFont(staffSize, dimin)->GetPointSize();
+
+    int xDC = ToDeviceContextX(x);
+    const int yDC = ToDeviceContextY(y);
+
+    // Same as DeviceContext::GetSmuflTextExtent
+    if (centered) {
+        int width = 0;
+        for (char32_t c : text) {
+            const Glyph *glyph = params.m_resources->GetGlyph(c);
+            if (!glyph) continue;
+            int gx, gy, gw, gh;
+            glyph->GetBoundingBox(gx, gy, gw, gh);
+            const int partialWidth = ceil(gw * pointSize / (double)glyph->GetUnitsPerEm());
+            const int advX = ceil(glyph->GetHorizAdvX() * pointSize / (double)glyph->GetUnitsPerEm());
+            width += (advX == 0) ? partialWidth : advX;
+        }
+        xDC -= width / 2;
+    }
+
+    // Same as BBoxDeviceContext::DrawMusicText
+    const char32_t smuflGlyph = (setBBGlyph && (text.length() == 1)) ? text.at(0) : 0;
+    for (char32_t c : text) {
+        const Glyph *glyph = params.m_resources->GetGlyph(c);
+        if (!glyph) continue;
+        int gx, gy, gw, gh;
+        glyph->GetBoundingBox(gx, gy, gw, gh);
+        const int unitsPerEm = glyph->GetUnitsPerEm();
+        const int xOff = xDC + gx * pointSize / unitsPerEm;
+        const int yOff = yDC - gy * pointSize / unitsPerEm;
+        this->UpdateMetricBB(params, xOff, yOff, xOff + gw * pointSize / unitsPerEm,
+            yOff - gh * pointSize / unitsPerEm, true, smuflGlyph, pointSize);
+        xDC += glyph->GetHorizAdvX() * pointSize / unitsPerEm;
+    }
+}
+
+void View::CalcMetricLine(MetricParams &params, int x1, int y1, int x2, int y2, int width, bool updateX)
+{
+    // Same as BBoxDeviceContext::DrawLine with the pen width set by View::DrawVerticalLine
+    const int penWidth = std::max(1, ToDeviceContextX(width));
+    int p1 = penWidth / 2;
+    const int p2 = p1;
+    if (penWidth % 2) {
+        p1++;
+    }
+
+    const int xDC1 = std::min(ToDeviceContextX(x1), ToDeviceContextX(x2));
+    const int xDC2 = std::max(ToDeviceContextX(x1), ToDeviceContextX(x2));
+    const int yDC1 = std::min(ToDeviceContextY(y1), ToDeviceContextY(y2));
+    const int yDC2 = std::max(ToDeviceContextY(y1), ToDeviceContextY(y2));
+
+    this->UpdateMetricBB(params, xDC1 - p1, yDC1 - p1, xDC2 + p2, yDC2 + p2, updateX);
+}
+
+void View::CalcMetricDots(MetricParams &params, int x, int y, unsigned char dots, const Staff *staff, bool dimin)
+{
+    assert(staff);
+
+    // Same as View::DrawDotsPart and View::DrawDot
+    const int unit = m_doc->GetDrawingUnit(staff->m_drawingStaffSize);
+    if (staff->IsOnStaffLine(y, m_doc)) {
+        y += unit;
+    }
+    const double distance = dimin ? m_doc->GetOptions()->m_graceFactor.GetValue() : 1.0;
+    int radius = std::max(ToDeviceContextX(m_doc->GetDrawingDoubleUnit(staff->m_drawingStaffSize) / 5), 2);
+    if (dimin) radius *= m_doc->GetOptions()->m_graceFactor.GetValue();
+
+    for (int i = 0; i < dots; ++i) {
+        const int xDC = ToDeviceContextX(x) - radius;
+        const int yDC = ToDeviceContextY(y) - radius;
+        this->UpdateMetricBB(params, xDC, yDC, xDC + 2 * radius, yDC + 2 * radius, true);
+        x += unit * 1.5 * distance;
+    }
+}
+
+void View::UpdateMetricBB(
+    MetricParams &params, int x1, int y1, int x2, int y2, bool updateX, char32_t glyph, int pointSize)
+{
+    assert(!params.m_objects.empty());
+
+    // Same as BBoxDeviceContext::UpdateBB
+    const int left = ToLogicalX(x1);
+    const int right = ToLogicalX(x2);
+    const int bottom = ToLogicalY(y1);
+    const int top = ToLogicalY(y2);
+
+    Object *object = params.m_objects.back();
+    if (updateX) {
+        object->UpdateSelfBBoxX(left, right);
+        if (glyph != 0) object->SetBoundingBoxGlyph(glyph, pointSize);
+    }
+    object->UpdateSelfBBoxY(bottom, top);
+    if (glyph != 0) object->SetBoundingBoxGlyph(glyph, pointSize);
+
+    for (Object *current : params.m_objects) {
+        if (updateX) current->UpdateContentBBoxX(left, right);
+        current->UpdateContentBBoxY(bottom, top);
+    }
+
+    if (updateX) {
+        params.m_x1 = std::min({ params.m_x1, left, right });
+        params.m_x2 = std::max({ params.m_x2, left, right });
+        params.m_hasX = true;
+    }
+    params.m_y1 = std::min({ params.m_y1, bottom, top });
+    params.m_y2 = std::max({ params.m_y2, bottom, top });
+    params.m_hasY = true;
+}
+
+} // namespace vrv
@@ -9,15 +9,18 @@
 
 //----------------------------------------------------------------------------
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <codecvt>
 #include <cstdlib>
 #include <iostream>
 #include <locale>
+#include <mutex>
 #include <sstream>
 #include <stdarg.h>
 #include <stdio.h>
+#include <string_view>
 #include <vector>
 
 #ifndef _WIN32
@@ -54,6 +57,7 @@
 #endif
 
 #define STRING_FORMAT_MAX_LEN 2048
+#define LOG_BUFFER_MAX_SIZE 1000
 
 namespace vrv {
 
@@ -72,6 +76,21 @@ bool loggingToBuffer = false;
 
 std::vector<std::string> logBuffer;
 
+/** The messages of the log buffer for fast lookup */
+std::unordered_set<std::string> logBufferSet;
+
+/** Transparent hash for looking up the codes with the format string (without a copy from C++20) */
+struct LogCodeHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view code) const { return std::hash<std::string_view>{}(code); }
+};
+
+/** The number of messages for each code logged to the buffer */
+std::unordered_map<std::string, LogCodeCount, LogCodeHash, std::equal_to<>> logCodeCounts;
+
+/** The buffer can be filled from several threads (e.g., when rendering transpositions) */
+std::mutex logBufferMutex;
+
 void LogElapsedTimeStart()
 {
     gettimeofday(&start, NULL);
@@ -92,6 +111,8 @@ void LogDebug(const char *fmt, ...)
     if (logLevel < LOG_DEBUG) return;
 
 #if defined(DEBUG)
+    if (!LogBufferCount(fmt, LOG_DEBUG)) return;
+
     std::string s;
     va_list args;
     va_start(args, fmt);
@@ -104,6 +125,7 @@ void LogDebug(const char *fmt, ...)
 void LogError(const char *fmt, ...)
 {
     if (logLevel < LOG_ERROR) return;
+    if (!LogBufferCount(fmt, LOG_ERROR)) return;
 
     std::string s;
     va_list args;
@@ -116,6 +138,7 @@ void LogError(const char *fmt, ...)
 void LogInfo(const char *fmt, ...)
 {
     if (logLevel < LOG_INFO) return;
+    if (!LogBufferCount(fmt, LOG_INFO)) return;
 
     std::string s;
     va_list args;
@@ -128,6 +151,7 @@ void LogInfo(const char *fmt, ...)
 void LogWarning(const char *fmt, ...)
 {
     if (logLevel < LOG_WARNING) return;
+    if (!LogBufferCount(fmt, LOG_WARNING)) return;
 
     std::string s;
     va_list args;
@@ -140,7 +164,9 @@ void LogWarning(const char *fmt, ...)
 void LogString(std::string message, LogLevel level)
 {
     if (loggingToBuffer) {
-        if (LogBufferContains(message)) return;
+        const std::lock_guard<std::mutex> lock(logBufferMutex);
+        if (logBuffer.size() >= LOG_BUFFER_MAX_SIZE) return;
+        if (!logBufferSet.insert(message).second) return;
         logBuffer.push_back(message);
     }
     else {
@@ -180,12 +206,50 @@ LogLevel StrToLogLevel(const std::string &level)
 
 bool LogBufferContains(const std::string &s)
 {
-    std::vector<std::string>::iterator iter = logBuffer.begin();
-    while (iter != logBuffer.end()) {
-        if ((*iter) == s) return true;
-        ++iter;
+    const std::lock_guard<std::mutex> lock(logBufferMutex);
+    return (logBufferSet.count(s) > 0);
+}
+
+bool LogBufferCount(const char *fmt, LogLevel level)
+{
+    if (!loggingToBuffer) return true;
+
+    const std::lock_guard<std::mutex> lock(logBufferMutex);
+    auto iter = logCodeCounts.find(fmt);
+    if (iter == logCodeCounts.end()) {
+        logCodeCounts.emplace(fmt, LogCodeCount{ level, 1 });
+    }
+    else {
+        ++iter->second.m_count;
+    }
+    // No need to format the message once the buffer is full
+    return (logBuffer.size() < LOG_BUFFER_MAX_SIZE);
+}
+
+std::vector<std::string> GetLogBuffer()
+{
+    const std::lock_guard<std::mutex> lock(logBufferMutex);
+    return logBuffer;
+}
+
+std::vector<std::pair<std::string, LogCodeCount>> GetLogCodeCounts()
+{
+    std::vector<std::pair<std::string, LogCodeCount>> codeCounts;
+    {
+        const std::lock_guard<std::mutex> lock(logBufferMutex);
+        codeCounts.assign(logCodeCounts.begin(), logCodeCounts.end());
     }
-    return false;
+    std::sort(codeCounts.begin(), codeCounts.end(),
+        [](const auto &a, const auto &b) { return (a.first < b.first); });
+    return codeCounts;
+}
+
+void ClearLogBuffer()
+{
+    const std::lock_guard<std::mutex> lock(logBufferMutex);
+    logBuffer.clear();
+    logBufferSet.clear();
+    logCodeCounts.clear();
 }
 
 bool Check(Object *object)
@@ -340,11 +404,6 @@ static const std::string base64Chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
                                        "abcdefghijklmnopqrstuvwxyz"
                                        "0123456789+/";
 
-static inline bool isBase64(unsigned char c)
-{
-    return (isalnum(c) || (c == '+') || (c == '/'));
-}
-
 std::string Base64Encode(unsigned char const *bytesToEncode, unsigned int inLen)
 {
     std::string ret;
@@ -383,27 +442,27 @@ std::string Base64Encode(unsigned char const *bytesToEncode, unsigned int inLen)
 
 std::vector<unsigned char> Base64Decode(std::string const &encodedString)
 {
-    int inLen = (int)encodedString.size();
+    // Lookup table of the base64 values, 0xFF for any other character (including '=')
+    static const std::vector<unsigned char> base64Values = []() {
+        std::vector<unsigned char> values(256, 0xFF);
+        for (int i = 0; i < (int)base64Chars.size(); ++i) values[(unsigned char)base64Chars.at(i)] = i;
+        return values;
+    }();
+
     int i = 0;
-    int in_ = 0;
-    unsigned char charArray4[4], charArray3[3];
+    unsigned char charArray4[4];
     std::vector<unsigned char> ret;
+    // Decoded chunks of four characters are appended without reallocating
+    ret.reserve(encodedString.size() / 4 * 3 + 3);
 
-    while (inLen-- && (encodedString[in_] != '=') && isBase64(encodedString[in_])) {
-        charArray4[i++] = encodedString[in_];
-        in_++;
+    for (const char c : encodedString) {
+        const unsigned char value = base64Values.at((unsigned char)c);
+        if (value == 0xFF) break;
+        charArray4[i++] = value;
         if (i == 4) {
-            for (i = 0; i < 4; ++i) {
-                charArray4[i] = base64Chars.find(charArray4[i]);
-            }
-
-            charArray3[0] = (charArray4[0] << 2) + ((charArray4[1] & 0x30) >> 4);
-            charArray3[1] = ((charArray4[1] & 0xf) << 4) + ((charArray4[2] & 0x3c) >> 2);
-            charArray3[2] = ((charArray4[2] & 0x3) << 6) + charArray4[3];
-
-            for (i = 0; (i < 3); ++i) {
-                ret.push_back(charArray3[i]);
-            }
+            ret.push_back((charArray4[0] << 2) + ((charArray4[1] & 0x30) >> 4));
+            ret.push_back(((charArray4[1] & 0xf) << 4) + ((charArray4[2] & 0x3c) >> 2));
+            ret.push_back(((charArray4[2] & 0x3) << 6) + charArray4[3]);
             i = 0;
         }
     }
@@ -413,10 +472,7 @@ std::vector<unsigned char> Base64Decode(std::string const &encodedString)
             charArray4[j] = 0;
         }
 
-        for (int j = 0; j < 4; ++j) {
-            charArray4[j] = base64Chars.find(charArray4[j]);
-        }
-
+        unsigned char charArray3[3];
         charArray3[0] = (charArray4[0] << 2) + ((charArray4[1] & 0x30) >> 4);
         charArray3[1] = ((charArray4[1] & 0xf) << 4) + ((charArray4[2] & 0x3c) >> 2);
         charArray3[2] = ((charArray4[2] & 0x3) << 6) + charArray4[3];
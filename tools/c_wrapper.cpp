@@ -42,6 +42,12 @@ void *vrvToolkit_constructorResourcePath(const char *resourcePath)
     return new Toolkit();
 }
 
+bool vrvToolkit_addToFeatureIndex(void *tkPtr, const char *name)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    return tk->AddToFeatureIndex(name);
+}
+
 void vrvToolkit_destructor(void *tkPtr)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -73,6 +79,13 @@ const char *vrvToolkit_getAvailableOptions(void *tkPtr)
     return tk->GetCString();
 }
 
+const char *vrvToolkit_getCacheStatistics(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->GetCacheStatistics());
+    return tk->GetCString();
+}
+
 const char *vrvToolkit_getDefaultOptions(void *tkPtr)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -145,6 +158,13 @@ const char *vrvToolkit_getLog(void *tkPtr)
     return tk->GetCString();
 }
 
+const char *vrvToolkit_getLogWithOptions(void *tkPtr, const char *c_options)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->GetLog((c_options) ? c_options : "{}"));
+    return tk->GetCString();
+}
+
 const char *vrvToolkit_getMEI(void *tkPtr, const char *options)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -152,6 +172,13 @@ const char *vrvToolkit_getMEI(void *tkPtr, const char *options)
     return tk->GetCString();
 }
 
+const unsigned char *vrvToolkit_getMEIBuffer(void *tkPtr, const char *options, int *length)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCBuffer(tk->GetMEI(options));
+    return tk->GetCBuffer(length);
+}
+
 const char *vrvToolkit_getMIDIValuesForElement(void *tkPtr, const char *xmlId)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -211,6 +238,12 @@ bool vrvToolkit_loadData(void *tkPtr, const char *data)
     return tk->LoadData(data);
 }
 
+bool vrvToolkit_loadFeatureIndex(void *tkPtr, const char *filename)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    return tk->LoadFeatureIndex(filename);
+}
+
 bool vrvToolkit_loadZipDataBase64(void *tkPtr, const char *data)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -223,6 +256,13 @@ bool vrvToolkit_loadZipDataBuffer(void *tkPtr, const unsigned char *data, int le
     return tk->LoadZipDataBuffer(data, length);
 }
 
+const char *vrvToolkit_queryFeatureIndex(void *tkPtr, const char *query)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->QueryFeatureIndex(query));
+    return tk->GetCString();
+}
+
 void vrvToolkit_redoLayout(void *tkPtr, const char *c_options)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -242,6 +282,13 @@ const char *vrvToolkit_renderData(void *tkPtr, const char *data, const char *opt
     return tk->GetCString();
 }
 
+const char *vrvToolkit_renderToGlyphSprite(void *tkPtr)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->RenderToGlyphSprite());
+    return tk->GetCString();
+}
+
 const char *vrvToolkit_renderToMIDI(void *tkPtr, const char *c_options)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -249,6 +296,13 @@ const char *vrvToolkit_renderToMIDI(void *tkPtr, const char *c_options)
     return tk->GetCString();
 }
 
+const unsigned char *vrvToolkit_renderToMIDIBuffer(void *tkPtr, int *length)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCBuffer(tk->RenderToMIDIBuffer());
+    return tk->GetCBuffer(length);
+}
+
 const char *vrvToolkit_renderToPAE(void *tkPtr)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -263,6 +317,20 @@ const char *vrvToolkit_renderToSVG(void *tkPtr, int page_no, bool xmlDeclaration
     return tk->GetCString();
 }
 
+const unsigned char *vrvToolkit_renderToSVGBuffer(void *tkPtr, int page_no, bool xmlDeclaration, int *length)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCBuffer(tk->RenderToSVG(page_no, xmlDeclaration));
+    return tk->GetCBuffer(length);
+}
+
+const unsigned char *vrvToolkit_renderToSVGZBuffer(void *tkPtr, int page_no, bool xmlDeclaration, int *length)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCBuffer(tk->RenderToSVGZBuffer(page_no, xmlDeclaration));
+    return tk->GetCBuffer(length);
+}
+
 const char *vrvToolkit_renderToTimemap(void *tkPtr, const char *c_options)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -270,6 +338,13 @@ const char *vrvToolkit_renderToTimemap(void *tkPtr, const char *c_options)
     return tk->GetCString();
 }
 
+const char *vrvToolkit_renderTranspositions(void *tkPtr, const char *data, const char *options)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->RenderTranspositions(data, options));
+    return tk->GetCString();
+}
+
 void vrvToolkit_resetOptions(void *tkPtr)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
@@ -282,6 +357,18 @@ void vrvToolkit_resetXmlIdSeed(void *tkPtr, int seed)
     tk->ResetXmlIdSeed(seed);
 }
 
+bool vrvToolkit_saveFeatureIndex(void *tkPtr, const char *filename)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    return tk->SaveFeatureIndex(filename);
+}
+
+bool vrvToolkit_saveSnapshot(void *tkPtr, const char *filename)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    return tk->SaveSnapshot(filename);
+}
+
 bool vrvToolkit_select(void *tkPtr, const char *selection)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
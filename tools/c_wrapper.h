@@ -19,9 +19,11 @@ void enableLogToBuffer(bool value);
 void *vrvToolkit_constructor();
 void *vrvToolkit_constructorResourcePath(const char *resourcePath);
 
+bool vrvToolkit_addToFeatureIndex(void *tkPtr, const char *name);
 void vrvToolkit_destructor(void *tkPtr);
 bool vrvToolkit_edit(void *tkPtr, const char *editorAction);
 const char *vrvToolkit_getAvailableOptions(void *tkPtr);
+const char *vrvToolkit_getCacheStatistics(void *tkPtr);
 const char *vrvToolkit_getDefaultOptions(void *tkPtr);
 const char *vrvToolkit_getDescriptiveFeatures(void *tkPtr, const char *options);
 const char *vrvToolkit_getElementAttr(void *tkPtr, const char *xmlId);
@@ -32,7 +34,9 @@ const char *vrvToolkit_convertHumdrumToHumdrum(void *tkPtr, const char *humdrumD
 const char *vrvToolkit_convertHumdrumToMIDI(void *tkPtr, const char *humdrumData);
 const char *vrvToolkit_convertMEIToHumdrum(void *tkPtr, const char *meiData);
 const char *vrvToolkit_getLog(void *tkPtr);
+const char *vrvToolkit_getLogWithOptions(void *tkPtr, const char *c_options);
 const char *vrvToolkit_getMEI(void *tkPtr, const char *options);
+const unsigned char *vrvToolkit_getMEIBuffer(void *tkPtr, const char *options, int *length);
 const char *vrvToolkit_getMIDIValuesForElement(void *tkPtr, const char *xmlId);
 const char *vrvToolkit_getNotatedIdForElement(void *tkPtr, const char *xmlId);
 const char *vrvToolkit_getOptions(void *tkPtr);
@@ -41,17 +45,26 @@ int vrvToolkit_getPageWithElement(void *tkPtr, const char *xmlId);
 double vrvToolkit_getTimeForElement(void *tkPtr, const char *xmlId);
 const char *vrvToolkit_getVersion(void *tkPtr);
 bool vrvToolkit_loadData(void *tkPtr, const char *data);
+bool vrvToolkit_loadFeatureIndex(void *tkPtr, const char *filename);
 bool vrvToolkit_loadZipDataBase64(void *tkPtr, const char *data);
 bool vrvToolkit_loadZipDataBuffer(void *tkPtr, const unsigned char *data, int length);
+const char *vrvToolkit_queryFeatureIndex(void *tkPtr, const char *query);
 void vrvToolkit_redoLayout(void *tkPtr, const char *c_options);
 void vrvToolkit_redoPagePitchPosLayout(void *tkPtr);
 const char *vrvToolkit_renderData(void *tkPtr, const char *data, const char *options);
+const char *vrvToolkit_renderToGlyphSprite(void *tkPtr);
 const char *vrvToolkit_renderToMIDI(void *tkPtr, const char *c_options);
+const unsigned char *vrvToolkit_renderToMIDIBuffer(void *tkPtr, int *length);
 const char *vrvToolkit_renderToPAE(void *tkPtr);
 const char *vrvToolkit_renderToSVG(void *tkPtr, int page_no, bool xmlDeclaration);
+const unsigned char *vrvToolkit_renderToSVGBuffer(void *tkPtr, int page_no, bool xmlDeclaration, int *length);
+const unsigned char *vrvToolkit_renderToSVGZBuffer(void *tkPtr, int page_no, bool xmlDeclaration, int *length);
 const char *vrvToolkit_renderToTimemap(void *tkPtr, const char *c_options);
+const char *vrvToolkit_renderTranspositions(void *tkPtr, const char *data, const char *options);
 void vrvToolkit_resetOptions(void *tkPtr);
 void vrvToolkit_resetXmlIdSeed(void *tkPtr, int seed);
+bool vrvToolkit_saveFeatureIndex(void *tkPtr, const char *filename);
+bool vrvToolkit_saveSnapshot(void *tkPtr, const char *filename);
 bool vrvToolkit_select(void *tkPtr, const char *selection);
 bool vrvToolkit_setOptions(void *tkPtr, const char *options);
 const char *vrvToolkit_validatePAE(void *tkPtr, const char *data);
@@ -5,16 +5,27 @@
 // Copyright (c) Authors and others. All rights reserved.
 /////////////////////////////////////////////////////////////////////////////
 
+#include <atomic>
 #include <cassert>
+#include <cerrno>
+#include <chrono>
 #include <fstream>
 #include <iostream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <regex>
 #include <sstream>
 #include <string>
 #include <sys/stat.h>
+#include <thread>
 
 #ifndef _WIN32
 #include <getopt.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 #else
 #include "win_getopt.h"
 #endif
@@ -43,6 +54,11 @@ std::string basename(std::string const &pathname)
     return std::string(std::find_if(pathname.rbegin(), pathname.rend(), MatchPathSeparator()).base(), pathname.end());
 }
 
+std::string dirname(std::string const &pathname)
+{
+    return std::string(pathname.begin(), std::find_if(pathname.rbegin(), pathname.rend(), MatchPathSeparator()).base());
+}
+
 std::string removeExtension(std::string const &filename)
 {
     std::string::const_reverse_iterator pivot = std::find(filename.rbegin(), filename.rend(), '.');
@@ -226,6 +242,471 @@ void display_usage(const vrv::Options *options, const std::string &category)
     }
 }
 
+// Convert the input files with a pool of worker threads, each one with its own toolkit
+// The status of each file is written to the standard output as a JSON line
+bool batch_convert(const std::vector<std::string> &infiles, const std::string &outdir, const std::string &outformat,
+    const std::string &inputfrom, const std::string &resourcePath, const vrv::Options *options, int page, bool all_pages)
+{
+    int jobs = options->m_jobs.GetValue();
+    if (jobs == 0) jobs = std::thread::hardware_concurrency();
+    jobs = std::clamp(jobs, 1, std::max(1, (int)infiles.size()));
+    const int seed = options->m_xmlIdSeed.GetValue();
+
+    // Output files are named after the input files without their directory, so input files with the same name
+    // cannot be converted together. Only the first one is, and the other ones are reported as failures.
+    std::vector<std::string> outnames;
+    std::vector<int> firstWithOutname;
+    std::map<std::string, int> outnameIndexes;
+    for (const std::string &infile : infiles) {
+        outnames.push_back(removeExtension(basename(infile)));
+        const auto [iter, inserted] = outnameIndexes.insert({ outnames.back(), (int)firstWithOutname.size() });
+        firstWithOutname.push_back(iter->second);
+    }
+
+    std::atomic<int> next = 0;
+    std::atomic<int> failures = 0;
+    std::mutex outputMutex;
+
+    auto convertFiles = [&]() {
+        vrv::Toolkit toolkit(false);
+        *toolkit.GetOptionsObj() = *options;
+        if (!inputfrom.empty()) toolkit.SetInputFrom(inputfrom);
+        toolkit.SetOutputTo(outformat);
+        toolkit.SkipLayoutOnLoad((outformat == "midi") || (outformat == "timemap"));
+        const bool hasFont = toolkit.SetResourcePath(resourcePath)
+            && toolkit.SetOptions(vrv::StringFormat("{\"font\": \"%s\" }", options->m_font.GetValue().c_str()));
+
+        for (int i = next++; i < (int)infiles.size(); i = next++) {
+            const std::string &infile = infiles.at(i);
+            const auto start = std::chrono::steady_clock::now();
+            const std::string outfile = outdir + "/" + outnames.at(i);
+            jsonxx::Array outfiles;
+            std::string error;
+
+            try {
+                // The generator of IDs is per thread and has to be seeded for each file
+                if (seed) vrv::Object::SeedID(seed);
+                if (firstWithOutname.at(i) != i) {
+                    error = "The output name '" + outnames.at(i) + "' is already used for "
+                        + infiles.at(firstWithOutname.at(i));
+                }
+                else if (!hasFont) {
+                    error = "The music font could not be loaded";
+                }
+                else if (!toolkit.LoadFile(infile)) {
+                    error = "The file could not be loaded";
+                }
+                else if ((outformat == "svg") || (outformat == "svgz")) {
+                    const bool svgz = (outformat == "svgz");
+                    const int from = (all_pages) ? 1 : page;
+                    const int to = (all_pages) ? toolkit.GetPageCount() : page;
+                    if (to > toolkit.GetPageCount()) error = "The page requested is not in the page range";
+                    for (int p = from; (p <= to) && error.empty(); ++p) {
+                        std::string cur_outfile = outfile;
+                        if (all_pages) cur_outfile += vrv::StringFormat("_%03d", p);
+                        cur_outfile += (svgz) ? ".svgz" : ".svg";
+                        const bool written = (svgz) ? toolkit.RenderToSVGZFile(cur_outfile, p)
+                                                    : toolkit.RenderToSVGFile(cur_outfile, p);
+                        if (!written) {
+                            error = ((svgz) ? "Unable to write SVGZ to " : "Unable to write SVG to ") + cur_outfile;
+                        }
+                        outfiles << cur_outfile;
+                    }
+                }
+                else if (outformat == "midi") {
+                    outfiles << outfile + ".mid";
+                    if (!toolkit.RenderToMIDIFile(outfile + ".mid")) error = "Unable to write MIDI to " + outfile + ".mid";
+                }
+                else if (outformat == "timemap") {
+                    outfiles << outfile + ".json";
+                    if (!toolkit.RenderToTimemapFile(outfile + ".json")) {
+                        error = "Unable to write the timemap to " + outfile + ".json";
+                    }
+                }
+                else {
+                    const char *scoreBased = (outformat == "mei-pb") ? "false" : "true";
+                    const char *basic = (outformat == "mei-basic") ? "true" : "false";
+                    const char *removeIds = (options->m_removeIds.GetValue()) ? "true" : "false";
+                    std::string params = (all_pages)
+                        ? vrv::StringFormat(
+                            "{'scoreBased': %s, 'basic': %s, 'removeIds': %s}", scoreBased, basic, removeIds)
+                        : vrv::StringFormat("{'scoreBased': %s, 'basic': %s, 'pageNo': %d, 'removeIds': %s}",
+                            scoreBased, basic, page, removeIds);
+                    outfiles << outfile + ".mei";
+                    if (!toolkit.SaveFile(outfile + ".mei", params)) error = "Unable to write MEI to " + outfile + ".mei";
+                }
+            }
+            catch (const std::exception &e) {
+                error = e.what();
+            }
+
+            jsonxx::Object status;
+            status << "input" << infile;
+            status << "status" << ((error.empty()) ? "ok" : "error");
+            if (!error.empty()) {
+                status << "error" << error;
+                ++failures;
+            }
+            else {
+                status << "outputs" << outfiles;
+            }
+            // Time in milliseconds
+            jsonxx::Value time(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+            time.precision_ = 3;
+            status << "time" << time;
+
+            // One line per file - line breaks and tabs can only be formatting since they are escaped in strings
+            std::string line = status.json();
+            line.erase(std::remove_if(line.begin(), line.end(), [](char c) { return (c == '\n') || (c == '\t'); }),
+                line.end());
+            const std::lock_guard<std::mutex> lock(outputMutex);
+            std::cout << line << std::endl;
+        }
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < jobs; ++i) threads.emplace_back(convertFiles);
+    for (std::thread &thread : threads) thread.join();
+
+    std::cerr << (int)infiles.size() - failures.load() << " file(s) converted and " << failures.load() << " failure(s) in "
+              << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << "s with " << jobs
+              << " thread(s)." << std::endl;
+
+    return (failures == 0);
+}
+
+//----------------------------------------------------------------------------
+// RenderServer
+//----------------------------------------------------------------------------
+
+// A server processing requests with a pool of documents, each one loaded in its own toolkit
+// Requests and responses are JSON objects, one per line: {"id": 1, "method": "renderToSVG", "params": {...}}
+// The toolkits are kept with their fonts loaded and reused for new documents when a document is closed or evicted
+class RenderServer {
+public:
+    RenderServer(const vrv::Options *options, const std::string &inputfrom, const std::string &resourcePath)
+        : m_options(options), m_inputfrom(inputfrom), m_resourcePath(resourcePath), m_nextHandle(1), m_running(true)
+    {
+    }
+
+    // Process a request and return the response
+    std::string Process(const std::string &request);
+
+    // Serve the requests from the standard input or from a UNIX socket until the end of the input or a shutdown
+    bool ServeStdio();
+    bool ServeSocket(const std::string &path);
+
+private:
+    // Process the method of a request and add its result to the response
+    bool Call(const std::string &method, const jsonxx::Object &params, jsonxx::Object &response, std::string &error);
+
+    // Return the toolkit of a document and make it the most recently used one
+    vrv::Toolkit *GetDocument(int handle);
+
+    // Add a document with a toolkit set to the default options, evicting the least recently used one if necessary
+    vrv::Toolkit *AddDocument(int &handle);
+
+    // Close a document and keep its toolkit for reuse
+    void CloseDocument(int handle);
+
+private:
+    const vrv::Options *m_options;
+    std::string m_inputfrom;
+    std::string m_resourcePath;
+    // The documents by handle, the most recently used one first
+    std::list<std::pair<int, std::unique_ptr<vrv::Toolkit>>> m_documents;
+    std::map<int, std::list<std::pair<int, std::unique_ptr<vrv::Toolkit>>>::iterator> m_handles;
+    // The toolkits of the closed documents
+    std::vector<std::unique_ptr<vrv::Toolkit>> m_toolkits;
+    int m_nextHandle;
+    bool m_running;
+};
+
+std::string RenderServer::Process(const std::string &request)
+{
+    jsonxx::Object json;
+    jsonxx::Object response;
+    std::string error;
+
+    if (!json.parse(request)) {
+        error = "The request is not a valid JSON object";
+    }
+    else {
+        if (json.has<jsonxx::Number>("id")) response << "id" << json.get<jsonxx::Number>("id");
+        if (json.has<jsonxx::String>("id")) response << "id" << json.get<jsonxx::String>("id");
+        const jsonxx::Object params
+            = (json.has<jsonxx::Object>("params")) ? json.get<jsonxx::Object>("params") : jsonxx::Object();
+        try {
+            this->Call(json.get<jsonxx::String>("method", ""), params, response, error);
+        }
+        catch (const std::exception &e) {
+            error = e.what();
+        }
+    }
+    if (!error.empty()) response << "error" << error;
+
+    // Line breaks and tabs can only be formatting since they are escaped in strings
+    std::string line = response.json();
+    line.erase(
+        std::remove_if(line.begin(), line.end(), [](char c) { return (c == '\n') || (c == '\t'); }), line.end());
+    return line;
+}
+
+bool RenderServer::Call(
+    const std::string &method, const jsonxx::Object &params, jsonxx::Object &response, std::string &error)
+{
+    if (method == "shutdown") {
+        m_running = false;
+        response << "result" << true;
+        return true;
+    }
+
+    int handle = params.get<jsonxx::Number>("handle", 0);
+    vrv::Toolkit *toolkit = NULL;
+    if ((method == "loadData") && (handle == 0)) {
+        toolkit = this->AddDocument(handle);
+    }
+    else {
+        toolkit = this->GetDocument(handle);
+    }
+    if (!toolkit) {
+        error = (handle == 0) ? "The toolkit could not be initialized" : "Unknown document handle";
+        return false;
+    }
+
+    // Results returned by the toolkit as stringified JSON are added as JSON
+    auto addJson = [&response](const std::string &json) {
+        jsonxx::Value value;
+        value.parse(json);
+        response << "result" << value;
+    };
+    const std::string xmlId = params.get<jsonxx::String>("xmlId", "");
+    const std::string options
+        = (params.has<jsonxx::Object>("options")) ? params.get<jsonxx::Object>("options").json() : "";
+
+    if (method == "loadData") {
+        if (!options.empty() && !toolkit->SetOptions(options)) {
+            error = "The options could not be set";
+        }
+        else if (params.has<jsonxx::String>("file") && !toolkit->LoadFile(params.get<jsonxx::String>("file"))) {
+            error = "The file could not be loaded";
+        }
+        else if (!params.has<jsonxx::String>("file") && !toolkit->LoadData(params.get<jsonxx::String>("data", ""))) {
+            error = "The data could not be loaded";
+        }
+        if (!error.empty()) {
+            this->CloseDocument(handle);
+            return false;
+        }
+        jsonxx::Object result;
+        result << "handle" << handle;
+        result << "pageCount" << toolkit->GetPageCount();
+        response << "result" << result;
+    }
+    else if (method == "setOptions") {
+        if (!toolkit->SetOptions(options)) {
+            error = "The options could not be set";
+            return false;
+        }
+        toolkit->RedoLayout();
+        response << "result" << toolkit->GetPageCount();
+    }
+    else if (method == "close") {
+        this->CloseDocument(handle);
+        response << "result" << true;
+    }
+    else if (method == "getPageCount") {
+        response << "result" << toolkit->GetPageCount();
+    }
+    else if (method == "renderToSVG") {
+        const int pageNo = params.get<jsonxx::Number>("pageNo", 1);
+        if ((pageNo < 1) || (pageNo > toolkit->GetPageCount())) {
+            error = "The page requested is not in the page range";
+            return false;
+        }
+        response << "result" << toolkit->RenderToSVG(pageNo, params.get<jsonxx::Boolean>("xmlDeclaration", false));
+    }
+    else if (method == "renderToMIDI") {
+        response << "result" << toolkit->RenderToMIDI();
+    }
+    else if (method == "renderToTimemap") {
+        addJson(toolkit->RenderToTimemap(options));
+    }
+    else if (method == "getMEI") {
+        response << "result" << toolkit->GetMEI(options);
+    }
+    else if (method == "getElementAttr") {
+        addJson(toolkit->GetElementAttr(xmlId));
+    }
+    else if (method == "getElementsAtTime") {
+        addJson(toolkit->GetElementsAtTime(params.get<jsonxx::Number>("millisec", 0)));
+    }
+    else if (method == "getMIDIValuesForElement") {
+        addJson(toolkit->GetMIDIValuesForElement(xmlId));
+    }
+    else if (method == "getPageWithElement") {
+        response << "result" << toolkit->GetPageWithElement(xmlId);
+    }
+    else if (method == "getTimesForElement") {
+        addJson(toolkit->GetTimesForElement(xmlId));
+    }
+    else {
+        error = "Unknown method '" + method + "'";
+        return false;
+    }
+    return true;
+}
+
+vrv::Toolkit *RenderServer::GetDocument(int handle)
+{
+    auto iter = m_handles.find(handle);
+    if (iter == m_handles.end()) return NULL;
+    m_documents.splice(m_documents.begin(), m_documents, iter->second);
+    return m_documents.front().second.get();
+}
+
+vrv::Toolkit *RenderServer::AddDocument(int &handle)
+{
+    std::unique_ptr<vrv::Toolkit> toolkit;
+    if (!m_toolkits.empty()) {
+        toolkit = std::move(m_toolkits.back());
+        m_toolkits.pop_back();
+    }
+    else if ((int)m_documents.size() >= m_options->m_serverDocuments.GetValue()) {
+        // Evict the least recently used document
+        toolkit = std::move(m_documents.back().second);
+        m_handles.erase(m_documents.back().first);
+        m_documents.pop_back();
+    }
+
+    if (toolkit) {
+        // Reset the options and the font that can have been changed for the previous document
+        const bool resetFont = (toolkit->GetOptionsObj()->m_font.GetValue() != m_options->m_font.GetValue());
+        *toolkit->GetOptionsObj() = *m_options;
+        if (resetFont) {
+            toolkit->SetOptions(vrv::StringFormat("{\"font\": \"%s\" }", m_options->m_font.GetValue().c_str()));
+        }
+    }
+    else {
+        toolkit = std::make_unique<vrv::Toolkit>(false);
+        *toolkit->GetOptionsObj() = *m_options;
+        if (!toolkit->SetResourcePath(m_resourcePath)
+            || !toolkit->SetOptions(
+                vrv::StringFormat("{\"font\": \"%s\" }", m_options->m_font.GetValue().c_str()))) {
+            return NULL;
+        }
+    }
+    toolkit->SetInputFrom((m_inputfrom.empty()) ? "auto" : m_inputfrom);
+
+    handle = m_nextHandle++;
+    m_documents.emplace_front(handle, std::move(toolkit));
+    m_handles[handle] = m_documents.begin();
+    return m_documents.front().second.get();
+}
+
+void RenderServer::CloseDocument(int handle)
+{
+    auto iter = m_handles.find(handle);
+    if (iter == m_handles.end()) return;
+    m_toolkits.push_back(std::move(iter->second->second));
+    m_documents.erase(iter->second);
+    m_handles.erase(iter);
+}
+
+bool RenderServer::ServeStdio()
+{
+    for (std::string line; m_running && getline(std::cin, line);) {
+        if (line.empty()) continue;
+        std::cout << this->Process(line) << std::endl;
+    }
+    return true;
+}
+
+bool RenderServer::ServeSocket(const std::string &path)
+{
+#ifndef _WIN32
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "The socket path " << path << " is too long." << std::endl;
+        return false;
+    }
+    strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    // A socket left by a previous server is replaced, but any other file is kept
+    struct stat status;
+    if (lstat(path.c_str(), &status) == 0) {
+        if (!S_ISSOCK(status.st_mode)) {
+            std::cerr << "The socket path " << path << " exists and is not a socket." << std::endl;
+            return false;
+        }
+        unlink(path.c_str());
+    }
+
+    const int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if ((server < 0) || (bind(server, (sockaddr *)&address, sizeof(address)) < 0) || (listen(server, 8) < 0)) {
+        std::cerr << "Unable to listen on the socket " << path << "." << std::endl;
+        if (server >= 0) close(server);
+        return false;
+    }
+    std::cerr << "Listening on " << path << "." << std::endl;
+
+    // Writing to a client that has disconnected must fail instead of raising SIGPIPE and terminating the server
+#ifdef MSG_NOSIGNAL
+    const int sendFlags = MSG_NOSIGNAL;
+#else
+    const int sendFlags = 0;
+#endif
+
+    // The clients are served one after the other and share the documents
+    while (m_running) {
+        const int client = accept(server, NULL, NULL);
+        if (client < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+#ifdef SO_NOSIGPIPE
+        const int noSigPipe = 1;
+        setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+        std::string buffer;
+        char chunk[65536];
+        bool connected = true;
+        while (connected && m_running) {
+            const ssize_t count = read(client, chunk, sizeof(chunk));
+            if ((count < 0) && (errno == EINTR)) continue;
+            if (count <= 0) break;
+            buffer.append(chunk, count);
+            size_t start = 0;
+            for (size_t end = buffer.find('\n'); connected && m_running && (end != std::string::npos);
+                 end = buffer.find('\n', start)) {
+                if (end > start) {
+                    const std::string response = this->Process(buffer.substr(start, end - start)) + "\n";
+                    for (size_t written = 0; connected && (written < response.size());) {
+                        const ssize_t result
+                            = send(client, response.data() + written, response.size() - written, sendFlags);
+                        if ((result < 0) && (errno == EINTR)) continue;
+                        // The client is dropped if the response cannot be written
+                        connected = (result > 0);
+                        if (connected) written += result;
+                    }
+                }
+                start = end + 1;
+            }
+            buffer.erase(0, start);
+        }
+        close(client);
+    }
+    close(server);
+    unlink(path.c_str());
+    return true;
+#else
+    std::cerr << "UNIX sockets are not supported on this platform." << std::endl;
+    return false;
+#endif
+}
+
 bool optionExists(const std::string &option, int argc, char **argv, std::string &badOption)
 {
     for (int i = 0; i < argc; ++i) {
@@ -238,13 +719,18 @@ bool optionExists(const std::string &option, int argc, char **argv, std::string
 int main(int argc, char **argv)
 {
     std::string infile;
+    std::string inputfrom;
+    std::string manifest;
+    std::string serversocket;
     std::string svgdir;
     std::string outfile;
     std::string outformat = "svg";
+    std::vector<std::string> queries;
     bool std_output = false;
 
     int all_pages = 0;
     int page = 1;
+    int server = 0;
     int show_version = 0;
 
     // Create the toolkit instance without loading the font because
@@ -254,11 +740,14 @@ int main(int argc, char **argv)
 
     static struct option base_options[] = { //
         { "all-pages", no_argument, 0, 'a' }, //
+        { "batch", required_argument, 0, 'b' }, //
         { "input-from", required_argument, 0, 'f' }, //
         { "help", required_argument, 0, 'h' }, //
+        { "jobs", required_argument, 0, 'j' }, //
         { "log-level", required_argument, 0, 'l' }, //
         { "outfile", required_argument, 0, 'o' }, //
         { "page", required_argument, 0, 'p' }, //
+        { "query", required_argument, 0, 'q' }, //
         { "resources", required_argument, 0, 'r' }, //
         { "scale", required_argument, 0, 's' }, //
         { "output-to", required_argument, 0, 't' }, //
@@ -266,6 +755,9 @@ int main(int argc, char **argv)
         { "xml-id-seed", required_argument, 0, 'x' }, //
         // standard input - long options only or - as filename
         { "stdin", no_argument, 0, 'z' }, //
+        // server mode - long options only
+        { "server", optional_argument, 0, 'S' }, //
+        { "server-documents", required_argument, 0, 'D' }, //
         { 0, 0, 0, 0 }
     };
 
@@ -319,7 +811,7 @@ int main(int argc, char **argv)
     vrv::Option *opt = NULL;
     vrv::OptionBool *optBool = NULL;
     std::string resourcePath = toolkit.GetResourcePath();
-    while ((c = getopt_long(argc, argv, "ab:f:h:l:o:p:r:s:t:vx:z", long_options, &option_index)) != -1) {
+    while ((c = getopt_long(argc, argv, "ab:f:h:j:l:o:p:q:r:s:t:vx:z", long_options, &option_index)) != -1) {
         switch (c) {
             case 0:
                 key = long_options[option_index].name;
@@ -347,10 +839,25 @@ int main(int argc, char **argv)
 
             case 'a': all_pages = 1; break;
 
+            case 'b': manifest = std::string(optarg); break;
+
+            case 'D':
+                if (!options->m_serverDocuments.SetValue(optarg)) {
+                    exit(1);
+                }
+                break;
+
             case 'f':
                 if (!toolkit.SetInputFrom(std::string(optarg))) {
                     exit(1);
                 };
+                inputfrom = std::string(optarg);
+                break;
+
+            case 'j':
+                if (!options->m_jobs.SetValue(optarg)) {
+                    exit(1);
+                }
                 break;
 
             case 'l': vrv::EnableLog(vrv::StrToLogLevel(std::string(optarg))); break;
@@ -359,6 +866,8 @@ int main(int argc, char **argv)
 
             case 'p': page = atoi(optarg); break;
 
+            case 'q': queries.push_back(std::string(optarg)); break;
+
             case 'r': resourcePath = optarg; break;
 
             case 't':
@@ -372,6 +881,11 @@ int main(int argc, char **argv)
                 }
                 break;
 
+            case 'S':
+                server = 1;
+                if (optarg) serversocket = std::string(optarg);
+                break;
+
             case 'v': show_version = 1; break;
 
             case 'x':
@@ -415,12 +929,46 @@ int main(int argc, char **argv)
     if (optind <= argc - 1) {
         infile = std::string(argv[optind]);
     }
-    else if (infile != "-") {
+    else if ((infile != "-") && manifest.empty() && !server) {
         std::cerr << "Incorrect number of arguments: expected one input file but found none." << std::endl << std::endl;
         display_usage(options, "base");
         exit(1);
     }
 
+    // Query a feature index file - no resources are needed
+    // The query option can be repeated, with the results of the queries written as a JSON array
+    if (!queries.empty()) {
+        if (!toolkit.LoadFeatureIndex(infile)) {
+            std::cerr << "The feature index '" << infile << "' could not be loaded." << std::endl;
+            exit(1);
+        }
+        std::string output;
+        for (const std::string &query : queries) {
+            const std::string result = toolkit.QueryFeatureIndex(query);
+            if (result.empty()) {
+                std::cerr << "The query '" << query << "' could not be processed." << std::endl;
+                exit(1);
+            }
+            if (!output.empty()) output += ",";
+            output += result;
+        }
+        if (queries.size() > 1) output = "[" + output + "]";
+        if (outfile.empty() || (outfile == "-")) {
+            std::cout << output << std::endl;
+        }
+        else {
+            outfile = removeExtension(outfile) + ".json";
+            std::ofstream outstream(outfile.c_str());
+            if (!outstream.is_open()) {
+                std::cerr << "Unable to write the query results to " << outfile << "." << std::endl;
+                exit(1);
+            }
+            outstream << output;
+            std::cerr << "Output written to " << outfile << "." << std::endl;
+        }
+        exit(0);
+    }
+
     // Make sure the user uses a valid Resource path
     // Save many headaches for empty SVGs
     if (!dir_exists(resourcePath)) {
@@ -441,11 +989,64 @@ int main(int argc, char **argv)
         exit(1);
     }
 
-    if ((outformat != "svg") && (outformat != "mei") && (outformat != "mei-basic") && (outformat != "mei-pb")
-        && (outformat != "midi") && (outformat != "timemap") && (outformat != "humdrum") && (outformat != "hum")
-        && (outformat != "pae")) {
+    // Server mode - the requests are read from the standard input or from the UNIX socket
+    if (server) {
+        RenderServer renderServer(options, inputfrom, resourcePath);
+        const bool success = (serversocket.empty()) ? renderServer.ServeStdio() : renderServer.ServeSocket(serversocket);
+        free(long_options);
+        return (success) ? 0 : 1;
+    }
+
+    // Batch mode - the input files are given in the manifest and as arguments
+    if (!manifest.empty()) {
+        std::vector<std::string> infiles;
+        std::ifstream manifeststream;
+        if (manifest != "-") {
+            manifeststream.open(manifest.c_str());
+            if (!manifeststream.is_open()) {
+                std::cerr << "The manifest '" << manifest << "' could not be opened." << std::endl;
+                exit(1);
+            }
+        }
+        std::istream &manifestinput = (manifest == "-") ? std::cin : manifeststream;
+        for (std::string line; getline(manifestinput, line);) {
+            if (!line.empty() && (line.back() == '\r')) line.pop_back();
+            if (!line.empty()) infiles.push_back(line);
+        }
+        for (int i = optind; i < argc; ++i) {
+            infiles.push_back(std::string(argv[i]));
+        }
+        if ((outformat != "svg") && (outformat != "svgz") && (outformat != "mei") && (outformat != "mei-basic")
+            && (outformat != "mei-pb") && (outformat != "midi") && (outformat != "timemap")) {
+            std::cerr << "Output format (" << outformat
+                      << ") in batch mode can only be 'mei', 'mei-basic', 'mei-pb', 'svg', 'svgz', 'midi' or 'timemap'."
+                      << std::endl;
+            exit(1);
+        }
+        if (!options->m_svgGlyphSprite.GetValue().empty()) {
+            std::cerr << "The glyph sprite cannot be used in batch mode." << std::endl;
+            exit(1);
+        }
+        // The output file is the output directory
+        if (outfile.empty()) outfile = ".";
+        if (!dir_exists(outfile)) {
+            std::cerr << "The output directory " << outfile << " could not be found." << std::endl;
+            exit(1);
+        }
+        const bool success
+            = batch_convert(infiles, outfile, outformat, inputfrom, resourcePath, options, page, all_pages);
+        free(long_options);
+        return (success) ? 0 : 1;
+    }
+
+    if ((outformat != "svg") && (outformat != "svgz") && (outformat != "mei") && (outformat != "mei-basic")
+        && (outformat != "mei-pb") && (outformat != "midi") && (outformat != "timemap") && (outformat != "humdrum")
+        && (outformat != "hum") && (outformat != "hummidi") && (outformat != "pae") && (outformat != "feature-index")
+        && (outformat != "snapshot")) {
         std::cerr << "Output format (" << outformat
-                  << ") can only be 'mei', 'mei-basic', 'mei-pb', 'svg', 'midi', 'humdrum' or 'pae'." << std::endl;
+                  << ") can only be 'mei', 'mei-basic', 'mei-pb', 'svg', 'svgz', 'midi', 'humdrum', 'hummidi', 'pae', "
+                     "'feature-index' or 'snapshot'."
+                  << std::endl;
         exit(1);
     }
 
@@ -467,13 +1068,15 @@ int main(int argc, char **argv)
         outfile = removeExtension(outfile);
     }
 
-    // Skip the layout for MIDI and timemap output
-    if ((outformat == "midi") || (outformat == "timemap")) {
+    // Skip the layout for MIDI, timemap, feature index and snapshot output
+    if ((outformat == "midi") || (outformat == "timemap") || (outformat == "feature-index")
+        || (outformat == "snapshot")) {
         toolkit.SkipLayoutOnLoad(true);
     }
 
-    // Load the std input or load the file
-    if (!((toolkit.GetOutputTo() == vrv::HUMDRUM) && (toolkit.GetInputFrom() == vrv::MEI))) {
+    // Load the std input or load the file - Humdrum-MIDI is converted directly from the Humdrum data
+    if (!((toolkit.GetOutputTo() == vrv::HUMDRUM) && (toolkit.GetInputFrom() == vrv::MEI))
+        && (toolkit.GetOutputTo() != vrv::HUMMIDI) && (outformat != "feature-index")) {
         if (infile == "-") {
             std::ostringstream data_stream;
             for (std::string line; getline(std::cin, line);) {
@@ -492,7 +1095,8 @@ int main(int argc, char **argv)
         }
     }
 
-    if (toolkit.GetOutputTo() != vrv::HUMDRUM) {
+    if ((toolkit.GetOutputTo() != vrv::HUMDRUM) && (toolkit.GetOutputTo() != vrv::HUMMIDI)
+        && (outformat != "feature-index")) {
         // Check the page range
         if (page > toolkit.GetPageCount()) {
             std::cerr << "The page requested (" << page << ") is not in the page range (max is "
@@ -531,6 +1135,26 @@ int main(int argc, char **argv)
             }
         }
     }
+    else if (outformat == "svgz") {
+        for (int p = from; p < to; ++p) {
+            std::string cur_outfile = outfile;
+            if (all_pages) {
+                cur_outfile += vrv::StringFormat("_%03d", p);
+            }
+            cur_outfile += ".svgz";
+            if (std_output) {
+                const std::string output = toolkit.RenderToSVGZBuffer(p, true);
+                std::cout.write(output.data(), output.size());
+            }
+            else if (!toolkit.RenderToSVGZFile(cur_outfile, p)) {
+                std::cerr << "Unable to write SVGZ to " << cur_outfile << "." << std::endl;
+                exit(1);
+            }
+            else {
+                std::cerr << "Output written to " << cur_outfile << "." << std::endl;
+            }
+        }
+    }
 
     else if (outformat == "hummidi") {
         std::string humdata;
@@ -562,15 +1186,62 @@ int main(int argc, char **argv)
         }
 
         std::string base64midi = toolkit.ConvertHumdrumToMIDI(humdata);
+        if (base64midi.empty()) {
+            std::cerr << "The input could not be converted to MIDI." << std::endl;
+            exit(1);
+        }
         if (std_output) {
             std::cout << base64midi << std::endl;
         }
         else {
-            std::cerr << "Humdrum-MIDI to file not yet implemented." << std::endl;
-            // outfile += ".mid";
-            // smf::MidiFile outputfile;
-            // outputfile.readBase64(base64midi);
-            // outputfile.write(outfile);
+            outfile += ".mid";
+            std::vector<unsigned char> midi = vrv::Base64Decode(base64midi);
+            std::ofstream outstream(outfile.c_str(), std::ios::binary);
+            if (!outstream.is_open()) {
+                std::cerr << "Unable to write MIDI to " << outfile << "." << std::endl;
+                exit(1);
+            }
+            outstream.write(reinterpret_cast<const char *>(midi.data()), midi.size());
+            std::cerr << "Output written to " << outfile << "." << std::endl;
+        }
+    }
+    else if (outformat == "feature-index") {
+        // All the remaining arguments are input files added to the index
+        outfile += ".vfi";
+        if (std_output) {
+            std::cerr << "Feature index cannot write to standard output." << std::endl;
+            exit(1);
+        }
+        for (int i = optind; i < argc; ++i) {
+            std::string indexfile = std::string(argv[i]);
+            if (!toolkit.LoadFile(indexfile)) {
+                std::cerr << "The file '" << indexfile << "' could not be opened." << std::endl;
+                continue;
+            }
+            if (!toolkit.AddToFeatureIndex(basename(indexfile))) {
+                std::cerr << "The file '" << indexfile << "' could not be added to the index." << std::endl;
+            }
+        }
+        if (!toolkit.SaveFeatureIndex(outfile)) {
+            std::cerr << "Unable to write the feature index to " << outfile << "." << std::endl;
+            exit(1);
+        }
+        else {
+            std::cerr << "Output written to " << outfile << "." << std::endl;
+        }
+    }
+    else if (outformat == "snapshot") {
+        outfile += ".vsnap";
+        if (std_output) {
+            std::cerr << "Snapshot cannot write to standard output." << std::endl;
+            exit(1);
+        }
+        else if (!toolkit.SaveSnapshot(outfile)) {
+            std::cerr << "Unable to write the snapshot to " << outfile << "." << std::endl;
+            exit(1);
+        }
+        else {
+            std::cerr << "Output written to " << outfile << "." << std::endl;
         }
     }
     else if (outformat == "midi") {
@@ -731,6 +1402,19 @@ int main(int argc, char **argv)
         }
     }
 
+    // Write the glyph sprite referenced by the pages next to them
+    if (((outformat == "svg") || (outformat == "svgz")) && !options->m_svgGlyphSprite.GetValue().empty()
+        && !std_output) {
+        const std::string spritefile = dirname(outfile) + options->m_svgGlyphSprite.GetValue();
+        if (!toolkit.RenderToGlyphSpriteFile(spritefile)) {
+            std::cerr << "Unable to write the glyph sprite to " << spritefile << "." << std::endl;
+            exit(1);
+        }
+        else {
+            std::cerr << "Output written to " << spritefile << "." << std::endl;
+        }
+    }
+
     // Display runtime if desired
     if (options->m_showRuntime.GetValue()) {
         toolkit.LogRuntime();